@@ -0,0 +1,427 @@
+#include "problem.hpp"
+#include "solver.hpp"
+#include "budget.hpp"
+#include "batch.hpp"
+#include "loader.hpp"
+#include "timer.hpp"
+#include "arguments.hpp"
+#include "stats.hpp"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <ctime>
+#include <stdexcept>
+
+/*
+	Benchmark of the engines on a set of instances under fixed schedule
+	budgets, reported as in the RCPSP literature: average deviation from the
+	critical path lower bound, rate of instances solved to optimality (the
+	makespan reaches a proven lower bound), schedules per second, wall time.
+
+	rcpsp_bench [--engines grasp,tabu,...] [--budgets 1000,5000,50000]
+	            [--repeat n] [--save-baseline file]
+	            [--baseline file [--max-slowdown %] [--max-worsening %]]
+	            [rcpsp_evo options] <instance>|--batch <directory|list-file>
+
+	With a baseline, the results are compared with the stored ones and the
+	exit status is 1 on a regression: the average makespan is exactly
+	reproducible for a seed (single thread), so it must not worsen by more
+	than --max-worsening (0 % by default); the throughput, measured in
+	processor time, varies between runs, so it fails when it is below the
+	baseline by more than --max-slowdown (10 % by default) and the
+	difference is significant with 95 % confidence over the repeats.
+*/
+
+/*
+	Results of an engine under a schedule budget
+*/
+struct Result
+{
+	Result() :
+		schedules( 0 ),
+		makespan( 0.0 ),
+		throughput( 0.0 ),
+		deviation( 0.0 ),
+		runs( 0 )
+	{
+	}
+
+	std::string engine;
+	int schedules;       // Budget
+	double makespan,     // Average makespan
+	       throughput,   // Mean of the schedules per second of the runs
+	       deviation;    // Standard deviation of the schedules per second
+	int runs;
+};
+
+// Version of the format of the baseline files
+const int baselineVersion( 1 );
+
+// Split a comma-separated list
+std::vector<std::string> split( const std::string & list )
+{
+	std::vector<std::string> words;
+	std::istringstream is( list );
+	std::string word;
+
+	while ( std::getline( is, word, ',' ) )
+	{
+		if ( !word.empty() )
+			words.push_back( word );
+	}
+	return words;
+}
+
+// Two-sided 95 % quantile of the Student t distribution with df degrees of freedom
+double student( int df )
+{
+	static const double t[] = { 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228 };
+	return df < 1 ? 0.0 : df <= 10 ? t[df-1] : df <= 30 ? 2.042 : 1.960;
+}
+
+// Half-width of the 95 % confidence interval of the mean throughput
+double confidence( const Result & r )
+{
+	return r.runs > 1 ? student( r.runs - 1 ) * r.deviation / std::sqrt( (double)r.runs ) : 0.0;
+}
+
+/*
+	Write the results with the instance set and the seed they depend on
+*/
+bool saveBaseline( const std::string & filename, const std::vector<Result> & results, int numInstances )
+{
+	std::ofstream os( filename.c_str() );
+
+	os << "# rcpsp_bench baseline " << baselineVersion << std::endl
+	   << "# instances " << numInstances << " random-seed " << arguments::random_seed << std::endl
+	   << "# engine schedules makespan schedules/s stddev runs" << std::endl;
+
+	os << std::fixed;
+	for ( int i = 0; i < (int)results.size(); ++i )
+	{
+		const Result & r( results[i] );
+		os << r.engine << ' ' << r.schedules << ' '
+		   << std::setprecision( 3 ) << r.makespan << ' '
+		   << std::setprecision( 1 ) << r.throughput << ' ' << r.deviation << ' '
+		   << r.runs << std::endl;
+	}
+	return os;
+}
+
+/*
+	Read the results of a baseline, which must be of the same instance set and seed
+*/
+bool loadBaseline( const std::string & filename, std::vector<Result> & results, int numInstances )
+{
+	std::ifstream is( filename.c_str() );
+	std::string line, word;
+	int version( 0 ), instances( 0 );
+	unsigned int seed( 0 );
+
+	// Header: "# rcpsp_bench baseline <version>"
+	std::getline( is, line );
+	std::istringstream header( line );
+	if ( !( header >> word >> word >> word >> version ) || version != baselineVersion )
+	{
+		std::clog << "Invalid baseline " << filename << std::endl;
+		return false;
+	}
+
+	// "# instances <n> random-seed <seed>"
+	std::getline( is, line );
+	std::istringstream set( line );
+	if ( !( set >> word >> word >> instances >> word >> seed ) || instances != numInstances || seed != arguments::random_seed )
+	{
+		std::clog << "The baseline " << filename << " was made with another instance set or seed" << std::endl;
+		return false;
+	}
+
+	results.clear();
+	while ( std::getline( is, line ) )
+	{
+		std::istringstream fields( line );
+		Result r;
+
+		if ( line.empty() || line[0] == '#' )
+			continue;
+
+		if ( fields >> r.engine >> r.schedules >> r.makespan >> r.throughput >> r.deviation >> r.runs )
+			results.push_back( r );
+	}
+	return true;
+}
+
+/*
+	Compare the results with the baseline, return the number of regressions
+*/
+int compare( const std::vector<Result> & results, const std::vector<Result> & baseline, double maxSlowdown, double maxWorsening )
+{
+	int regressions( 0 );
+
+	std::cout
+		<< std::endl
+		<< std::left << std::setw( 12 ) << "Engine" << std::right
+		<< std::setw( 10 ) << "Schedules"
+		<< std::setw( 12 ) << "Makespan"
+		<< std::setw( 12 ) << "Baseline"
+		<< std::setw( 14 ) << "Schedules/s"
+		<< std::setw( 12 ) << "Baseline"
+		<< std::setw( 10 ) << "Change"
+		<< "  Status" << std::endl;
+
+	for ( int i = 0; i < (int)results.size(); ++i )
+	{
+		const Result & r( results[i] );
+		const Result * b( 0 );
+		const char * status( "ok" );
+
+		for ( int j = 0; j < (int)baseline.size() && b == 0; ++j )
+		{
+			if ( baseline[j].engine == r.engine && baseline[j].schedules == r.schedules )
+				b = &baseline[j];
+		}
+
+		if ( b == 0 )
+		{
+			std::cout << std::left << std::setw( 12 ) << r.engine << std::right
+			          << std::setw( 10 ) << r.schedules << "  not in the baseline" << std::endl;
+			continue;
+		}
+
+		// Quality: deterministic, compared exactly up to the tolerance
+		if ( r.makespan > b->makespan * ( 1.0 + maxWorsening / 100.0 ) + 1e-6 )
+			status = "WORSE MAKESPAN";
+
+		// Throughput: slower than the tolerated floor, and by more than the
+		// confidence interval of the difference of the means (not noise)
+		else
+		{
+			double floor( b->throughput * ( 1.0 - maxSlowdown / 100.0 ) ),
+			       error( std::sqrt( r.deviation * r.deviation / std::max( 1, r.runs )
+			                       + b->deviation * b->deviation / std::max( 1, b->runs ) ) );
+
+			if ( r.throughput < floor && b->throughput - r.throughput > student( std::min( r.runs, b->runs ) - 1 ) * error )
+				status = "SLOWER";
+		}
+
+		if ( std::strcmp( status, "ok" ) != 0 )
+			++regressions;
+
+		std::cout
+			<< std::left << std::setw( 12 ) << r.engine << std::right
+			<< std::setw( 10 ) << r.schedules
+			<< std::fixed << std::setprecision( 2 )
+			<< std::setw( 12 ) << r.makespan
+			<< std::setw( 12 ) << b->makespan
+			<< std::setprecision( 0 )
+			<< std::setw( 14 ) << r.throughput
+			<< std::setw( 12 ) << b->throughput
+			<< std::setprecision( 1 )
+			<< std::setw( 9 ) << 100.0 * ( r.throughput - b->throughput ) / std::max( 1e-9, b->throughput ) << '%'
+			<< "  " << status << std::endl;
+		std::cout.unsetf( std::ios::fixed );
+	}
+
+	std::cout << std::endl << ( regressions ? "Performance regression" : "No performance regression" ) << std::endl;
+	return regressions;
+}
+
+int main( int argc, char * argv[] )
+{
+	std::vector<std::string> engines( split( "grasp,tabu,annealing" ) ),
+	                         budgets( split( "1000,5000,50000" ) );
+	std::vector<char *> options;
+	std::vector<std::string> filenames;
+	std::vector<Problem> problems;
+	std::vector<Result> results;
+	std::string baselineName, saveName;
+	double maxSlowdown( 10.0 ), maxWorsening( 0.0 );
+	int repeat( 1 );
+
+	// The benchmark options, the others are the options of the solver
+	for ( int i = 0; i < argc; ++i )
+	{
+		if ( std::strcmp( argv[i], "--engines" ) == 0 && i+1 < argc )
+			engines = split( argv[++i] );
+		else if ( std::strcmp( argv[i], "--budgets" ) == 0 && i+1 < argc )
+			budgets = split( argv[++i] );
+		else if ( std::strcmp( argv[i], "--repeat" ) == 0 && i+1 < argc )
+			std::istringstream( argv[++i] ) >> repeat;
+		else if ( std::strcmp( argv[i], "--baseline" ) == 0 && i+1 < argc )
+			baselineName = argv[++i];
+		else if ( std::strcmp( argv[i], "--save-baseline" ) == 0 && i+1 < argc )
+			saveName = argv[++i];
+		else if ( std::strcmp( argv[i], "--max-slowdown" ) == 0 && i+1 < argc )
+			std::istringstream( argv[++i] ) >> maxSlowdown;
+		else if ( std::strcmp( argv[i], "--max-worsening" ) == 0 && i+1 < argc )
+			std::istringstream( argv[++i] ) >> maxWorsening;
+		else
+			options.push_back( argv[i] );
+	}
+	arguments::parse( options.size(), &options[0] );
+	repeat = std::max( 1, repeat );
+
+	// Reproducible runs
+	if ( arguments::random_seed == 0 )
+		arguments::random_seed = 1;
+
+	if ( !arguments::batch.empty() )
+	{
+		Batch batch;
+		if ( !batch.load( arguments::batch ) )
+		{
+			std::clog << "Invalid batch" << std::endl;
+			return 1;
+		}
+		for ( int i = 0; i < batch.size(); ++i )
+			filenames.push_back( batch.getFilename( i ) );
+	}
+	else if ( !arguments::filename.empty() )
+		filenames.push_back( arguments::filename );
+	else
+	{
+		std::cout << "Usage: " << argv[0] << " [--engines grasp,tabu,...] [--budgets 1000,5000,50000] [--repeat n] [--save-baseline file] [--baseline file [--max-slowdown %] [--max-worsening %]] [options] <instance>|--batch <directory|list-file>" << std::endl;
+		return 0;
+	}
+
+	// Load the instances once for all the runs
+	problems.reserve( filenames.size() );
+	for ( int i = 0; i < (int)filenames.size(); ++i )
+	{
+		Problem p;
+		try
+		{
+			if ( loader::load( filenames[i], p ) )
+			{
+				problems.push_back( p );
+				continue;
+			}
+			std::clog << "Invalid file name " << filenames[i] << std::endl;
+		}
+		catch ( const std::exception & e )
+		{
+			std::clog << "Invalid instance " << filenames[i] << ": " << e.what() << std::endl;
+		}
+	}
+
+	if ( problems.empty() )
+		return 1;
+
+	std::cout
+		<< "Instances: " << problems.size() << ", random seed: " << arguments::random_seed
+		<< ", runs: " << repeat << std::endl
+		<< std::endl
+		<< std::left << std::setw( 12 ) << "Engine" << std::right
+		<< std::setw( 10 ) << "Schedules"
+		<< std::setw( 12 ) << "Makespan"
+		<< std::setw( 14 ) << "Dev. CPM (%)"
+		<< std::setw( 13 ) << "Optimal (%)"
+		<< std::setw( 14 ) << "Schedules/s"
+		<< std::setw( 10 ) << "+/- 95%"
+		<< std::setw( 10 ) << "Time (s)" << std::endl;
+
+	Solver solver;
+	solver.setNumThreads( arguments::threads );
+
+	for ( int e = 0; e < (int)engines.size(); ++e )
+	{
+		for ( int b = 0; b < (int)budgets.size(); ++b )
+		{
+			Result result;
+			double deviation( 0.0 ), sum( 0.0 ), sumSquares( 0.0 );
+			int optimal( 0 );
+			Timer timer;
+
+			arguments::engine = arguments::getEngine( engines[e] );
+			std::istringstream( budgets[b] ) >> arguments::max_schedules;
+
+			// The same runs again: only the throughput changes (with repeats, a
+			// first run warms the caches up and is not measured)
+			for ( int run = repeat > 1 ? -1 : 0; run < repeat; ++run )
+			{
+				double solveTime( 0.0 ), makespan( 0.0 );
+				long schedules( 0 );
+
+				deviation = 0.0;
+				optimal = 0;
+
+				for ( int i = 0; i < (int)problems.size(); ++i )
+				{
+					const Problem & p( problems[i] );
+					Budget budget;
+
+					// Seeded as in a batch: the same results as rcpsp_evo --batch.
+					// The throughput is measured in processor time, which other
+					// processes of the machine do not inflate as they do the wall time
+					solver.setSeed( arguments::random_seed + i );
+					std::clock_t clock( std::clock() );
+					solver.solve( p, budget );
+					solveTime += double( std::clock() - clock ) / CLOCKS_PER_SEC;
+
+					makespan += solver.getBestCmax();
+					deviation += 100.0 * ( solver.getBestCmax() - p.getCriticalPathBound() ) / std::max( 1, p.getCriticalPathBound() );
+					optimal += ( solver.getBestCmax() <= solver.getLowerBound() );
+					schedules += budget.getNumSchedules();
+				}
+
+				if ( run < 0 )
+					continue;
+
+				double throughput( schedules / std::max( 1e-9, solveTime ) );
+				sum += throughput;
+				sumSquares += throughput * throughput;
+				result.makespan = makespan / problems.size();
+			}
+
+			result.engine = arguments::getEngineName( arguments::engine );
+			result.schedules = arguments::max_schedules;
+			result.runs = repeat;
+			result.throughput = sum / repeat;
+			result.deviation = repeat > 1 ? std::sqrt( std::max( 0.0, ( sumSquares - sum * sum / repeat ) / ( repeat - 1 ) ) ) : 0.0;
+			results.push_back( result );
+
+			std::cout
+				<< std::left << std::setw( 12 ) << result.engine << std::right
+				<< std::setw( 10 ) << result.schedules
+				<< std::fixed << std::setprecision( 2 )
+				<< std::setw( 12 ) << result.makespan
+				<< std::setw( 14 ) << deviation / problems.size()
+				<< std::setw( 13 ) << 100.0 * optimal / problems.size()
+				<< std::setprecision( 0 )
+				<< std::setw( 14 ) << result.throughput
+				<< std::setw( 10 ) << confidence( result )
+				<< std::setprecision( 2 )
+				<< std::setw( 10 ) << timer.getElapsed() << std::endl;
+			std::cout.unsetf( std::ios::fixed );
+		}
+	}
+
+	if ( !saveName.empty() )
+	{
+		if ( !saveBaseline( saveName, results, problems.size() ) )
+		{
+			std::clog << "Cannot write the baseline " << saveName << std::endl;
+			return 1;
+		}
+		std::cout << std::endl << "Baseline saved to " << saveName << std::endl;
+	}
+
+	if ( !baselineName.empty() )
+	{
+		std::vector<Result> baseline;
+
+		if ( !loadBaseline( baselineName, baseline, problems.size() ) || compare( results, baseline, maxSlowdown, maxWorsening ) > 0 )
+			return 1;
+	}
+
+	if ( arguments::stats )
+		stats::report( std::cout );
+
+	return 0;
+}
@@ -0,0 +1,309 @@
+#include "problem.hpp"
+#include "solution.hpp"
+#include "resource.hpp"
+#include "generator.hpp"
+#include "timer.hpp"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+/*
+	Microbenchmarks of the kernels of the serial decoder: the resource
+	tables (getAvailable, findSpace, assign) and the solution procedures
+	(getMinStartTimeOfJob, update, grasp). Each kernel reports ns per
+	operation, and CPU cycles per operation when the perf counters are
+	available.
+
+	rcpsp_micro [--horizon t] [--capacity c] [--resources r] [--jobs n]
+	            [--operations k] [--random-seed s]
+*/
+
+/*
+	CPU cycles of the calling thread, from the perf counters (Linux only)
+*/
+class CycleCounter
+{
+public:
+	CycleCounter() :
+		_fd( -1 )
+	{
+#ifdef __linux__
+		struct perf_event_attr attr;
+
+		std::memset( &attr, 0, sizeof( attr ) );
+		attr.type = PERF_TYPE_HARDWARE;
+		attr.size = sizeof( attr );
+		attr.config = PERF_COUNT_HW_CPU_CYCLES;
+		attr.disabled = 1;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+
+		_fd = syscall( __NR_perf_event_open, &attr, 0, -1, -1, 0 );
+#endif
+	}
+
+	~CycleCounter()
+	{
+#ifdef __linux__
+		if ( _fd >= 0 )
+			close( _fd );
+#endif
+	}
+
+	bool isAvailable() const
+	{
+		return _fd >= 0;
+	}
+
+	void start()
+	{
+#ifdef __linux__
+		if ( _fd >= 0 )
+		{
+			ioctl( _fd, PERF_EVENT_IOC_RESET, 0 );
+			ioctl( _fd, PERF_EVENT_IOC_ENABLE, 0 );
+		}
+#endif
+	}
+
+	/*
+		Stop counting, return the number of cycles since start()
+	*/
+	double stop()
+	{
+		double cycles( 0.0 );
+#ifdef __linux__
+		if ( _fd >= 0 )
+		{
+			long count( 0 );
+			ioctl( _fd, PERF_EVENT_IOC_DISABLE, 0 );
+			if ( read( _fd, &count, sizeof( count ) ) == (ssize_t)sizeof( count ) )
+				cycles = count;
+		}
+#endif
+		return cycles;
+	}
+
+private:
+	int _fd;
+};
+
+/*
+	Time and cycles accumulated by a kernel
+*/
+struct Measure
+{
+	Measure() :
+		operations( 0 ),
+		seconds( 0.0 ),
+		cycles( 0.0 )
+	{
+	}
+
+	void start()
+	{
+		counter.start();
+		timer.start();
+	}
+
+	void stop( long n )
+	{
+		seconds += timer.getElapsed();
+		cycles += counter.stop();
+		operations += n;
+	}
+
+	long operations;
+	double seconds,
+	       cycles;
+	Timer timer;
+	CycleCounter counter;
+};
+
+void report( const char * kernel, const Measure & m )
+{
+	std::cout
+		<< std::left << std::setw( 32 ) << kernel << std::right
+		<< std::setw( 12 ) << m.operations
+		<< std::fixed << std::setprecision( 1 )
+		<< std::setw( 12 ) << 1e9 * m.seconds / std::max( 1L, m.operations );
+
+	if ( m.counter.isAvailable() )
+		std::cout << std::setw( 14 ) << m.cycles / std::max( 1L, m.operations );
+	else
+		std::cout << std::setw( 14 ) << "n/a";
+
+	std::cout << std::endl;
+	std::cout.unsetf( std::ios::fixed );
+}
+
+// A volatile sink keeps the results of the kernels alive
+volatile long sink;
+
+int main( int argc, char * argv[] )
+{
+	int horizon( 1000 ), capacity( 10 ), numResources( 4 ), numJobs( 120 ), operations( 100000 );
+	unsigned int seed( 1 );
+
+	for ( int i = 1; i+1 < argc; i += 2 )
+	{
+		std::istringstream value( argv[i+1] );
+
+		if ( std::strcmp( argv[i], "--horizon" ) == 0 )
+			value >> horizon;
+		else if ( std::strcmp( argv[i], "--capacity" ) == 0 )
+			value >> capacity;
+		else if ( std::strcmp( argv[i], "--resources" ) == 0 )
+			value >> numResources;
+		else if ( std::strcmp( argv[i], "--jobs" ) == 0 )
+			value >> numJobs;
+		else if ( std::strcmp( argv[i], "--operations" ) == 0 )
+			value >> operations;
+		else if ( std::strcmp( argv[i], "--random-seed" ) == 0 )
+			value >> seed;
+		else
+		{
+			std::cout << "Usage: " << argv[0] << " [--horizon t] [--capacity c] [--resources r] [--jobs n] [--operations k] [--random-seed s]" << std::endl;
+			return 0;
+		}
+	}
+
+	std::srand( seed );
+	std::cout
+		<< "Horizon: " << horizon << ", capacity: " << capacity
+		<< ", resources: " << numResources << ", jobs: " << numJobs << std::endl
+		<< std::endl
+		<< std::left << std::setw( 32 ) << "Kernel" << std::right
+		<< std::setw( 12 ) << "Operations"
+		<< std::setw( 12 ) << "ns/op"
+		<< std::setw( 14 ) << "cycles/op" << std::endl;
+
+	// Resource kernels on a table half full
+	{
+		Resource resource( horizon, capacity );
+		std::vector<int> t( operations ), req( operations ), duration( operations );
+		Measure available, space, assign;
+		long total( 0 );
+
+		for ( int i = 0; i < operations; ++i )
+		{
+			t[i] = std::rand() % horizon;
+			req[i] = 1 + std::rand() % capacity;
+			duration[i] = 1 + std::rand() % 10;
+		}
+
+		for ( int u = 0; u < horizon; ++u )
+		{
+			for ( int r = 0; r < capacity; ++r )
+			{
+				if ( std::rand() % 2 )
+					resource.setUsage( u, r, 1 );
+			}
+		}
+
+		available.start();
+		for ( int i = 0; i < operations; ++i )
+			total += resource.getAvailable( t[i] );
+		available.stop( operations );
+		report( "Resource::getAvailable", available );
+
+		space.start();
+		for ( int i = 0; i < operations; ++i )
+			total += resource.findSpace( t[i], req[i], duration[i] );
+		space.stop( operations );
+		report( "Resource::findSpace", space );
+
+		// Assign into empty tables, cleared outside of the measure when half full
+		for ( int i = 0; i < operations; )
+		{
+			int n( 0 ), filled( 0 );
+
+			resource.reset();
+			assign.start();
+			for ( ; i < operations && filled + req[i] * duration[i] <= horizon * capacity / 2; ++i, ++n )
+			{
+				resource.assign( std::max( 0, std::min( t[i], horizon - duration[i] ) ), req[i], duration[i], 1 );
+				filled += req[i] * duration[i];
+			}
+			assign.stop( n );
+
+			// A single operation larger than the half of the table
+			if ( n == 0 )
+				++i;
+		}
+		report( "Resource::assign", assign );
+
+		sink = total;
+	}
+
+	// Solution kernels on a generated instance
+	{
+		Problem p;
+		Generator generator( seed );
+		Measure minStart, update, grasp;
+		long total( 0 );
+		int numLists( std::max( 1, operations / std::max( 1, numJobs ) ) );
+
+		generator.setNumJobs( numJobs );
+		generator.setNumResources( numResources );
+		generator.generate( p );
+
+		Solution s( p );
+
+		grasp.start();
+		for ( int i = 0; i < numLists; ++i )
+		{
+			s.grasp( 0.75, seed );
+			total += s.getCmax();
+		}
+		grasp.stop( numLists );
+
+		update.start();
+		for ( int i = 0; i < numLists; ++i )
+		{
+			s.update();
+			total += s.getCmax();
+		}
+		update.stop( numLists );
+
+		// In the state of the decoder: the positions before i are scheduled and
+		// the tail is free. update( i, -1 ) abandons the decoding at i (no job
+		// starts before 0) and undo( i, i ) restores the schedule, both outside
+		// of the measure; a few calls per state amortize the timer
+		const int calls( 32 );
+		for ( int n = 0; n < operations; )
+		{
+			s.grasp( 0.75, seed );
+			for ( int i = 0; i < s.size() && n < operations; ++i )
+			{
+				int k( std::min( calls, operations - n ) );
+
+				s.update( i, -1 );
+				minStart.start();
+				for ( int c = 0; c < k; ++c )
+					total += s.getMinStartTimeOfJob( s[i] );
+				minStart.stop( k );
+				s.undo( i, i );
+				n += k;
+			}
+		}
+
+		report( "Solution::getMinStartTimeOfJob", minStart );
+		report( "Solution::update", update );
+		report( "Solution::grasp", grasp );
+
+		sink = total;
+	}
+
+	return 0;
+}
@@ -0,0 +1,67 @@
+#include "problem.hpp"
+#include "generator.hpp"
+#include "psplib.hpp"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <cstdlib>
+#include <stdexcept>
+
+/*
+	Round trip of the PSPLIB writer: generated instances are written, parsed
+	back and written again, which must give the same text. The sizes go up to
+	J10000 and beyond, where the numbers fill the widths of their fields.
+
+	rcpsp_roundtrip [jobs...]
+*/
+
+// Return true if the instance of n jobs survives the round trip
+bool roundtrip( int n, unsigned int seed )
+{
+	Problem p, q;
+	Generator generator( seed );
+	std::ostringstream first, second;
+
+	generator.setNumJobs( n );
+	generator.generate( p );
+	psplib::write( first, p );
+
+	const std::string text( first.str() );
+	try
+	{
+		psplib::parse( text.data(), text.data() + text.size(), q );
+	}
+	catch ( const std::exception & e )
+	{
+		std::cout << "J" << n << ": " << e.what() << std::endl;
+		return false;
+	}
+
+	psplib::write( second, q );
+	if ( second.str() != text || q.getNumJobs() != p.getNumJobs() || q.getCriticalPathBound() != p.getCriticalPathBound() )
+	{
+		std::cout << "J" << n << ": the parsed instance differs" << std::endl;
+		return false;
+	}
+
+	std::cout << "J" << n << ": ok" << std::endl;
+	return true;
+}
+
+int main( int argc, char * argv[] )
+{
+	int failures( 0 );
+
+	if ( argc < 2 )
+	{
+		// Sizes and seeds: whether a number fills its field depends on the instance
+		const int runs[][2] = { { 30, 1 }, { 120, 1 }, { 10000, 1 }, { 10000, 2 }, { 10000, 3 }, { 12000, 1 } };
+		for ( int i = 0; i < (int)( sizeof( runs ) / sizeof( runs[0] ) ); ++i )
+			failures += !roundtrip( runs[i][0], runs[i][1] );
+	}
+
+	for ( int i = 1; i < argc; ++i )
+		failures += !roundtrip( std::atoi( argv[i] ), i );
+
+	return failures > 0;
+}
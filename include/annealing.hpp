@@ -0,0 +1,158 @@
+#ifndef ANNEALING_HPP
+#define ANNEALING_HPP
+
+#include "problem.hpp"
+#include "solution.hpp"
+#include "timer.hpp"
+#include "archive.hpp"
+#include "budget.hpp"
+#include <vector>
+#include <iostream>
+
+/*
+	A simulated annealing on activity lists.
+	The random number deciding the acceptance of a move is drawn before the
+	move is evaluated, so it gives the largest makespan that can be accepted:
+	the decoding of a candidate is abandoned as soon as it exceeds it.
+*/
+class SimulatedAnnealing
+{
+public:
+	SimulatedAnnealing( const Problem & p );
+
+	// Cooling schedules
+	enum
+	{
+		Geometric = 0, // T <- rate * T
+		Adaptive       // T <- max( 0.5, exp( -0.7 T / sigma ) ) * T (Huang et al.)
+	};
+
+	/*
+		Set the initial temperature
+	*/
+	void setTemperature( double t0 );
+
+	/*
+		Set the cooling schedule and the rate used by the geometric schedule
+	*/
+	void setCooling( int schedule, double rate );
+
+	/*
+		Set the number of temperature stages without improvement before reheating
+		(0 means never)
+	*/
+	void setReheat( int stages );
+
+	/*
+		Set the maximal number of schedules evaluated
+	*/
+	void setMaxEvaluations( int n );
+
+	/*
+		Set the shared stopping criteria, e.g. a wall-clock limit (0 means none)
+	*/
+	void setBudget( Budget * budget );
+
+	/*
+		Set the archive shared with the other solvers (0 means none): new best
+		solutions are published there, and reheats restart from its best list
+	*/
+	void setArchive( Archive * archive );
+
+	/*
+		Set the seed of the random moves and of the acceptance test
+	*/
+	void setSeed( unsigned int seed );
+
+	/*
+		Improve the solution s, which ends up being the best solution found
+	*/
+	void solve( Solution & s );
+
+	/*
+		Return the number of schedules evaluated by the last search
+	*/
+	int getNumEvaluations() const;
+
+	/*
+		Return the duration of the last search in seconds
+	*/
+	double getElapsedTime() const;
+
+	/*
+		Write a summary of the last search (evaluations/sec, reheats, ...)
+	*/
+	void exportSummary( std::ostream & os ) const;
+
+private:
+	int _numJobs,
+	    _schedule,
+	    _reheat,
+	    _maxEvaluations,
+	    _numEvaluations,
+	    _numAborted,
+	    _numReheats;
+
+	Archive * _archive;
+	Budget * _budget;
+	unsigned int _seed;
+
+	double _t0,
+	       _rate,
+	       _elapsed;
+
+	/*
+		Compute the temperature of the next stage
+	*/
+	double cool( double t, double sum, double sum2, int n ) const;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline void SimulatedAnnealing::setTemperature( double t0 )
+{
+	_t0 = t0;
+}
+
+inline void SimulatedAnnealing::setCooling( int schedule, double rate )
+{
+	_schedule = schedule;
+	_rate = rate;
+}
+
+inline void SimulatedAnnealing::setReheat( int stages )
+{
+	_reheat = stages;
+}
+
+inline void SimulatedAnnealing::setMaxEvaluations( int n )
+{
+	_maxEvaluations = n;
+}
+
+inline void SimulatedAnnealing::setBudget( Budget * budget )
+{
+	_budget = budget;
+}
+
+inline void SimulatedAnnealing::setArchive( Archive * archive )
+{
+	_archive = archive;
+}
+
+inline int SimulatedAnnealing::getNumEvaluations() const
+{
+	return _numEvaluations;
+}
+
+inline double SimulatedAnnealing::getElapsedTime() const
+{
+	return _elapsed;
+}
+
+inline void SimulatedAnnealing::setSeed( unsigned int seed )
+{
+	_seed = seed;
+}
+
+#endif
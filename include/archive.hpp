@@ -0,0 +1,128 @@
+#ifndef ARCHIVE_HPP
+#define ARCHIVE_HPP
+
+#include "solution.hpp"
+#include "budget.hpp"
+#include <vector>
+#include <pthread.h>
+
+/*
+	The best solutions found by all the solver threads.
+	The incumbent (best makespan and best list) and the elite lists are read
+	without locks: entries are immutable once published, a new version is
+	swapped in with an atomic pointer store, and replaced versions are only
+	freed with the archive (improvements are few, so this is cheap).
+	Publishing the incumbent is lock-free; inserting an elite takes a mutex.
+*/
+class Archive
+{
+public:
+	/*
+		An immutable published list
+	*/
+	struct Entry
+	{
+		int cmax;
+		std::vector<int> sequence;
+		Entry * retired; // Next entry of the retired list
+	};
+
+	Archive( int capacity );
+	~Archive();
+
+	/*
+		Set the budget where the improvements of the incumbent are recorded
+	*/
+	void setBudget( Budget * budget );
+
+	/*
+		Offer the list of a solution (thread-safe), return true if it is a new incumbent
+	*/
+	bool publish( const Solution & s );
+
+	/*
+		Return the best makespan published, or the max int (lock-free)
+	*/
+	int getBestCmax() const;
+
+	/*
+		Return the best list published, or 0 (lock-free)
+	*/
+	const Entry * getBest() const;
+
+	/*
+		Return the number of elite lists (lock-free)
+	*/
+	int size() const;
+
+	/*
+		Return the elite list i < size() (lock-free)
+	*/
+	const Entry * get( int i ) const;
+
+private:
+	volatile int _bestCmax;
+	Entry * volatile _best;
+	Entry * volatile _retired;
+
+	Entry * volatile * _slots; // Sorted by makespan
+	int _capacity;
+	volatile int _size;
+	pthread_mutex_t _mutex; // Serializes the elite insertions
+
+	Budget * _budget;
+
+	/*
+		Replace the incumbent if the entry is better, without lock
+	*/
+	bool improve( Entry * e );
+
+	/*
+		Insert an entry among the elites (mutex held)
+	*/
+	bool insert( Entry * e );
+
+	/*
+		Keep an entry replaced while readers may still hold it
+	*/
+	void retire( Entry * e );
+
+	// Not copyable
+	Archive( const Archive & );
+	Archive & operator = ( const Archive & );
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline void Archive::setBudget( Budget * budget )
+{
+	_budget = budget;
+}
+
+inline int Archive::getBestCmax() const
+{
+	return _bestCmax;
+}
+
+inline const Archive::Entry * Archive::getBest() const
+{
+	const Entry * e = _best;
+	__sync_synchronize(); // The entry is read after the pointer
+	return e;
+}
+
+inline int Archive::size() const
+{
+	int n = _size;
+	__sync_synchronize(); // The slots are read after the size
+	return n;
+}
+
+inline const Archive::Entry * Archive::get( int i ) const
+{
+	const Entry * e = _slots[i];
+	__sync_synchronize();
+	return e;
+}
+
+#endif
@@ -21,6 +21,17 @@ struct arguments
 	*/
 	static void print( std::ostream & os = std::cout );
 
+	/*
+		Return the engine of a name (grasp, tabu, annealing, scatter or exact),
+		GRASP if unknown
+	*/
+	static int getEngine( const std::string & name );
+
+	/*
+		Return the name of an engine
+	*/
+	static const char * getEngineName( int engine );
+
 	/*
 		Display usage
 	*/
@@ -29,11 +40,36 @@ struct arguments
 	// Integer parameters
 	static int
 		population_size,
+		local_search,
+		local_search_moves,
+		engine,
+		iterations,
+		tabu_tenure,
+		tabu_sample,
+		sa_cooling,
+		sa_reheat,
+		sa_evaluations,
+		path_relinking,
+		elite_size,
+		elite_distance,
+		threads,
+		refset_quality,
+		refset_diversity,
+		dedup,
+		diversity_window,
+		max_schedules,
+		target_makespan,
+		stagnation,
 		print_problem,
 		print_graph,
 		print_table,
 		print_plot,
 		verbose,
+		compile,
+		stats,
+		generate_jobs,
+		generate_resources,
+		generate_count,
 		help;
 
 	// Positive integer parameters
@@ -42,17 +78,70 @@ struct arguments
 
 	// Float parameters
 	static double
-		alpha;
+		alpha,
+		sa_temperature,
+		sa_rate,
+		time_limit,
+		diversity_threshold,
+		network_complexity,
+		resource_factor,
+		resource_strength;
 
 	// Identifiers
 	enum
 	{
-		id_random_seed = 0x100
+		id_random_seed = 0x100,
+		id_local_search,
+		id_local_search_moves,
+		id_engine,
+		id_iterations,
+		id_tabu_tenure,
+		id_tabu_sample,
+		id_sa_temperature,
+		id_sa_cooling,
+		id_sa_rate,
+		id_sa_reheat,
+		id_sa_evaluations,
+		id_time_limit,
+		id_elite_size,
+		id_elite_distance,
+		id_threads,
+		id_refset_quality,
+		id_refset_diversity,
+		id_diversity_window,
+		id_diversity_threshold,
+		id_max_schedules,
+		id_target_makespan,
+		id_stagnation,
+		id_trace,
+		id_batch,
+		id_generate_jobs,
+		id_generate_resources,
+		id_generate_count,
+		id_network_complexity,
+		id_resource_factor,
+		id_resource_strength
+	};
+
+	// Engines
+	enum
+	{
+		engine_grasp = 0,
+		engine_tabu,
+		engine_annealing,
+		engine_scatter,
+		engine_exact
 	};
 
 	// Instance file name
 	static std::string filename;
 
+	// Improvement trace file name (CSV)
+	static std::string trace;
+
+	// Directory or list file of the instances of a batch
+	static std::string batch;
+
 	// getopt long options array
 	static const struct option long_options[];
 };
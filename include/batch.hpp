@@ -0,0 +1,72 @@
+#ifndef BATCH_HPP
+#define BATCH_HPP
+
+#include <vector>
+#include <string>
+#include <iostream>
+
+/*
+	Solve many instances on a thread pool.
+	Each worker thread takes the next instance, solves it and writes its CSV
+	line (instance, lower bound, makespan, time, schedules) as soon as it is
+	done; the problem and the solver of a worker are reused from an instance
+	to the next.
+*/
+class Batch
+{
+public:
+	Batch();
+
+	/*
+		Add the instance files of a directory (except the compiled caches), or
+		of a list file (one file name per line, blank lines and lines starting
+		with # are skipped).
+		Return false if the path cannot be read.
+	*/
+	bool load( const std::string & path );
+
+	/*
+		Return the number of instances
+	*/
+	int size() const;
+
+	/*
+		Return the file name of the instance i
+	*/
+	const std::string & getFilename( int i ) const;
+
+	/*
+		Set the random seed: the instance i is solved with seed+i whatever the
+		worker thread, so the results are reproducible
+	*/
+	void setSeed( unsigned int seed );
+
+	/*
+		Solve the instances with n worker threads (0 means one per processor)
+		and write the results to os
+	*/
+	void run( int n, std::ostream & os ) const;
+
+private:
+	std::vector<std::string> _filenames;
+	unsigned int _seed;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline void Batch::setSeed( unsigned int seed )
+{
+	_seed = seed;
+}
+
+inline int Batch::size() const
+{
+	return _filenames.size();
+}
+
+inline const std::string & Batch::getFilename( int i ) const
+{
+	return _filenames[i];
+}
+
+#endif
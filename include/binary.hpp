@@ -0,0 +1,62 @@
+#ifndef BINARY_HPP
+#define BINARY_HPP
+
+#include "problem.hpp"
+#include <string>
+
+/*
+	Compiled instances: a flat binary image of a preprocessed problem
+	(durations, request matrix, precedences in CSR form, capacities, bounds
+	and time windows) loaded with a few copies, without parsing nor
+	preprocessing.
+	The image records the hash and the size of its source file, a cache
+	X.sm.bin is used instead of X.sm only while they match.
+*/
+struct binary
+{
+	/*
+		Return true if the buffer holds a compiled instance
+	*/
+	static bool isBinary( const char * begin, const char * end );
+
+	/*
+		Read the problem from a compiled instance, return false if it is
+		malformed or was compiled on another architecture
+	*/
+	static bool read( const char * begin, const char * end, Problem & p );
+
+	/*
+		Write the compiled instance of p (preprocessed) to a file, with the
+		hash and the size of its source; return false if it cannot be written
+	*/
+	static bool save( const std::string & filename, const Problem & p, unsigned int sourceHash, long sourceSize );
+
+	/*
+		Load the problem from the cache of a source file if it is fresh,
+		return false otherwise
+	*/
+	static bool loadCache( const std::string & source, const char * begin, const char * end, Problem & p );
+
+	/*
+		Compile a source instance into its cache, return false if it cannot
+		be read or written (a malformed instance throws std::runtime_error)
+	*/
+	static bool compile( const std::string & source );
+
+	/*
+		Return the name of the cache of a source file
+	*/
+	static std::string getCacheName( const std::string & source );
+
+	/*
+		Return the hash of a source file (FNV-1a)
+	*/
+	static unsigned int hash( const char * begin, const char * end );
+
+	/*
+		File name extension of the caches
+	*/
+	static const char * const extension;
+};
+
+#endif
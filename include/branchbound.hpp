@@ -0,0 +1,187 @@
+#ifndef BRANCHBOUND_HPP
+#define BRANCHBOUND_HPP
+
+#include "problem.hpp"
+#include "solution.hpp"
+#include "archive.hpp"
+#include "budget.hpp"
+#include "propagator.hpp"
+#include <vector>
+#include <iostream>
+
+/*
+	An exact depth-first branch and bound for small instances.
+	A node extends a partial schedule with an eligible job started as early as
+	possible (serial scheme), so that the search enumerates active schedules.
+	Nodes are pruned with:
+	- the left-shift rule: the jobs must be scheduled by nondecreasing start
+	  times (ties in topological order), otherwise the same schedule is reached
+	  through another order;
+	- the critical path and energy bounds of the remaining jobs;
+	- the time windows propagated for a better makespan (see Propagator);
+	- the cutset rule: a node is dominated by a node already explored with the
+	  same set of scheduled jobs, an earlier decision time and jobs in progress
+	  finishing earlier (the cutsets are memorized in a hash table).
+	The search stack and the hash table are allocated once, before the search.
+*/
+class BranchAndBound
+{
+public:
+	BranchAndBound( const Problem & p );
+
+	/*
+		Set the number of cutsets memorized (rounded down to a power of two, 0 means none)
+	*/
+	void setMemoSize( int n );
+
+	/*
+		Set the archive where the new best solutions are published (0 means none)
+	*/
+	void setArchive( Archive * archive );
+
+	/*
+		Set the shared stopping criteria (0 means none)
+	*/
+	void setBudget( Budget * budget );
+
+	/*
+		Search for a better solution than s, which ends up being the best solution found.
+		Return true if the search is complete (s is optimal)
+	*/
+	bool solve( Solution & s );
+
+	/*
+		Return the lower bound of Cmax proven by the last search
+	*/
+	int getLowerBound() const;
+
+	/*
+		Return the number of nodes of the last search
+	*/
+	long getNumNodes() const;
+
+	/*
+		Return the number of nodes pruned by the cutset rule in the last search
+	*/
+	long getNumCutsets() const;
+
+	/*
+		Show the statistics of the last search
+	*/
+	void exportSummary( std::ostream & os ) const;
+
+private:
+	const Problem & _problem;
+
+	int _numJobs,
+	    _numResources,
+	    _numWords,     // Number of words of a cutset
+	    _upperBound,   // Makespan of the best solution
+	    _lowerBound;   // Lower bound proven
+
+	long _numNodes,
+	     _numCutsets;
+
+	Archive * _archive;
+	Budget * _budget;
+
+	// Instance data
+	std::vector<int> _rank;      // Position of the job in the topological order
+
+	// Partial schedule
+	std::vector<int> _start,     // Start time of the job (-1 if not scheduled)
+	                 _numPreds,  // Number of predecessors not scheduled
+	                 _usage,     // usage[t*R+k] is the usage of the resource k at period t
+	                 _head;      // Earliest start time of the jobs not scheduled (bound)
+	std::vector<unsigned long> _cutset, // Bit set of the scheduled jobs
+	                           _zobrist; // Random key of each job
+	unsigned long _hash;         // Hash of the cutset
+
+	// Search stack: level l schedules the job _job[l]
+	std::vector<int> _job,
+	                 _bound,       // Lower bound of the node
+	                 _numEligible, // Number of jobs eligible at the level
+	                 _next,        // Next eligible job to try
+	                 _first,       // Position of the eligible jobs of the level in the stack
+	                 _eligible,    // eligible[first[l]+i] is the i-th job eligible at the level l
+	                 _eligibleStart, // Its earliest start time
+	                 _mark;        // Mark of the propagation before the level
+
+	Propagator _propagator;
+
+	// Cutsets memorized (open addressing)
+	int _memoMask;
+	std::vector<unsigned long> _memoKey;
+	std::vector<int> _memoTime,   // Decision time (start time of the last job)
+	                 _memoRank,   // Rank of the last job
+	                 _memoCount,  // Number of jobs in progress (-1 if the slot is empty)
+	                 _memoFinish; // Jobs in progress and their finish times (pairs)
+
+	/*
+		Return the earliest start time of j in the partial schedule,
+		or -1 if it cannot end before the upper bound
+	*/
+	int findStart( int j ) const;
+
+	/*
+		Add the job j starting at t to the partial schedule at the level l,
+		return false if the propagation proves it cannot lead to a better schedule
+	*/
+	bool schedule( int l, int j, int t );
+
+	/*
+		Remove the job of the level l from the partial schedule
+	*/
+	void unschedule( int l );
+
+	/*
+		Propagate the windows again for a new upper bound, along the levels before l
+	*/
+	void restart( int l );
+
+	/*
+		Fill the eligible jobs of the level l, which do not break the left-shift rule
+	*/
+	void expand( int l );
+
+	/*
+		Return a lower bound of the completions of the partial schedule, where
+		no job starts before t
+	*/
+	int computeBound( int t );
+
+	/*
+		Return true if the partial schedule, whose last job j starts at t, is
+		dominated by a memorized one (otherwise it is memorized)
+	*/
+	bool isDominated( int j, int t );
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline void BranchAndBound::setArchive( Archive * archive )
+{
+	_archive = archive;
+}
+
+inline void BranchAndBound::setBudget( Budget * budget )
+{
+	_budget = budget;
+}
+
+inline int BranchAndBound::getLowerBound() const
+{
+	return _lowerBound;
+}
+
+inline long BranchAndBound::getNumNodes() const
+{
+	return _numNodes;
+}
+
+inline long BranchAndBound::getNumCutsets() const
+{
+	return _numCutsets;
+}
+
+#endif
@@ -0,0 +1,140 @@
+#ifndef BUDGET_HPP
+#define BUDGET_HPP
+
+#include "timer.hpp"
+#include <vector>
+#include <iostream>
+#include <pthread.h>
+
+/*
+	Stopping criteria shared by all the engines and threads, and the trace of
+	the improvements of the best makespan.
+	Engines report the schedules they evaluate with count() and poll
+	isExhausted(); the archive reports each new best with record().
+*/
+class Budget
+{
+public:
+	Budget();
+	~Budget();
+
+	/*
+		Set the maximal number of seconds (0 means no limit)
+	*/
+	void setTimeLimit( double seconds );
+
+	/*
+		Set the maximal number of schedules evaluated (0 means no limit)
+	*/
+	void setMaxSchedules( long n );
+
+	/*
+		Stop as soon as the best makespan reaches cmax (0 means never)
+	*/
+	void setTarget( int cmax );
+
+	/*
+		Stop after n schedules without improvement of the best makespan (0 means never)
+	*/
+	void setStagnation( long n );
+
+	/*
+		Return true if a time or schedule limit is set
+	*/
+	bool isLimited() const;
+
+	/*
+		Add n schedules evaluated (thread-safe)
+	*/
+	void count( long n );
+
+	/*
+		Record a new best makespan (thread-safe)
+	*/
+	void record( int cmax );
+
+	/*
+		Return true if a stopping criterion is met (thread-safe)
+	*/
+	bool isExhausted() const;
+
+	/*
+		Return the number of schedules evaluated
+	*/
+	long getNumSchedules() const;
+
+	/*
+		Return the number of seconds since the creation of the budget
+	*/
+	double getElapsed() const;
+
+	/*
+		Write the improvement trace as CSV: time, schedules, makespan
+	*/
+	void exportTrace( std::ostream & os ) const;
+
+private:
+	Timer _timer;
+	double _timeLimit;
+	long _maxSchedules,
+	     _stagnation;
+	int _target;
+
+	volatile long _numSchedules,
+	              _lastImprovement; // Number of schedules at the last improvement
+	volatile int _bestCmax;
+	mutable volatile bool _stopped;
+
+	std::vector<double> _traceTime;
+	std::vector<long> _traceSchedules;
+	std::vector<int> _traceCmax;
+	mutable pthread_mutex_t _mutex; // Protects the trace
+
+	// Not copyable
+	Budget( const Budget & );
+	Budget & operator = ( const Budget & );
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline void Budget::setTimeLimit( double seconds )
+{
+	_timeLimit = seconds;
+}
+
+inline void Budget::setMaxSchedules( long n )
+{
+	_maxSchedules = n;
+}
+
+inline void Budget::setTarget( int cmax )
+{
+	_target = cmax;
+}
+
+inline void Budget::setStagnation( long n )
+{
+	_stagnation = n;
+}
+
+inline bool Budget::isLimited() const
+{
+	return _timeLimit > 0.0 || _maxSchedules > 0;
+}
+
+inline void Budget::count( long n )
+{
+	__sync_fetch_and_add( &_numSchedules, n );
+}
+
+inline long Budget::getNumSchedules() const
+{
+	return _numSchedules;
+}
+
+inline double Budget::getElapsed() const
+{
+	return _timer.getElapsed();
+}
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef ELITE_HPP
+#define ELITE_HPP
+
+#include "solution.hpp"
+#include <vector>
+
+/*
+	A bounded pool of elite activity lists.
+	A list enters the pool only if it is far enough from every elite list
+	(number of positions holding different jobs), unless it is better than
+	all of them. When the pool is full, it replaces the most similar elite
+	among the ones it improves.
+*/
+class ElitePool
+{
+public:
+	ElitePool( int capacity, int minDistance );
+
+	/*
+		Try to insert the list of the solution s, return true if inserted
+	*/
+	bool insert( const Solution & s );
+
+	/*
+		Return the number of elite lists
+	*/
+	int size() const;
+
+	/*
+		Return the elite list i
+	*/
+	const std::vector<int> & getSequence( int i ) const;
+
+	/*
+		Return the makespan of the elite list i
+	*/
+	int getCmax( int i ) const;
+
+	/*
+		Return the index of the best elite list
+	*/
+	int getBest() const;
+
+	/*
+		Return the number of positions holding different jobs in two lists
+	*/
+	static int distance( const std::vector<int> & a, const std::vector<int> & b );
+
+private:
+	int _capacity,
+	    _minDistance;
+
+	std::vector< std::vector<int> > _sequences;
+	std::vector<int> _cmax;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline int ElitePool::size() const
+{
+	return _sequences.size();
+}
+
+inline const std::vector<int> & ElitePool::getSequence( int i ) const
+{
+	return _sequences[i];
+}
+
+inline int ElitePool::getCmax( int i ) const
+{
+	return _cmax[i];
+}
+
+#endif
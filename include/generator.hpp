@@ -0,0 +1,117 @@
+#ifndef GENERATOR_HPP
+#define GENERATOR_HPP
+
+#include "problem.hpp"
+#include <vector>
+
+/*
+	A generator of random instances in the spirit of ProGen, controlled by
+	- the network complexity: average number of arcs per job (source and
+	  sink included), without redundant arcs;
+	- the resource factor: fraction of the resources requested by a job;
+	- the resource strength: position of each capacity between the largest
+	  request (0) and the peak usage of the earliest start schedule (1).
+	Durations and requests are drawn in [1,10], a job has at most 3
+	successors and 3 predecessors (the source and the sink excepted).
+	The instances only depend on the seed and the parameters.
+*/
+class Generator
+{
+public:
+	Generator( unsigned int seed );
+
+	/*
+		Set the number of non-dummy jobs
+	*/
+	void setNumJobs( int n );
+
+	/*
+		Set the number of renewable resources
+	*/
+	void setNumResources( int n );
+
+	/*
+		Set the network complexity (arcs per job)
+	*/
+	void setNetworkComplexity( double nc );
+
+	/*
+		Set the resource factor (in [0,1])
+	*/
+	void setResourceFactor( double rf );
+
+	/*
+		Set the resource strength (in [0,1])
+	*/
+	void setResourceStrength( double rs );
+
+	/*
+		Build the next instance in p, preprocessed
+	*/
+	void generate( Problem & p );
+
+private:
+	unsigned int _seed;
+	int _numJobs,
+	    _numResources;
+	double _networkComplexity,
+	       _resourceFactor,
+	       _resourceStrength;
+
+	std::vector< std::vector<int> > _successors,
+	                                _predecessors;
+	std::vector<int> _visited, // Search of the paths: mark of the last search visiting a job
+	                 _stack;
+	int _mark;
+
+	/*
+		Return a random integer in [lo,hi]
+	*/
+	int random( int lo, int hi );
+
+	/*
+		Return true if j is a (transitive) successor of i, searching the jobs
+		between them (the arcs go from lower to higher job numbers)
+	*/
+	bool isReachable( int i, int j );
+
+	/*
+		Try to add the arc i -> j between non-dummy jobs, return false if it
+		breaks the degree limits or is (or makes another arc) redundant
+	*/
+	bool addArc( int i, int j );
+
+	/*
+		Build the precedence network of the jobs 1..n (0 is the source, n+1 the sink)
+	*/
+	void generateNetwork();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline void Generator::setNumJobs( int n )
+{
+	_numJobs = n;
+}
+
+inline void Generator::setNumResources( int n )
+{
+	_numResources = n;
+}
+
+inline void Generator::setNetworkComplexity( double nc )
+{
+	_networkComplexity = nc;
+}
+
+inline void Generator::setResourceFactor( double rf )
+{
+	_resourceFactor = rf;
+}
+
+inline void Generator::setResourceStrength( double rs )
+{
+	_resourceStrength = rs;
+}
+
+#endif
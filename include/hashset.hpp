@@ -0,0 +1,84 @@
+#ifndef HASHSET_HPP
+#define HASHSET_HPP
+
+#include "solution.hpp"
+#include <vector>
+
+/*
+	A set of schedules identified by the hash of their start times.
+	Open addressing with linear probing in a power-of-two table, so that two
+	lists decoding to the same schedule are detected with a few probes.
+	It also measures the share of distinct schedules among the last
+	candidates, which tells when the search stops producing new schedules.
+*/
+class HashSet
+{
+public:
+	HashSet( int window, double threshold );
+
+	/*
+		Insert the schedule of s, return false if it is already in the set
+	*/
+	bool insert( const Solution & s );
+
+	/*
+		Insert a hash, return false if it is already in the set
+	*/
+	bool insert( unsigned long h );
+
+	/*
+		Remove all the schedules (the table keeps its size)
+	*/
+	void clear();
+
+	/*
+		Return the number of schedules in the set
+	*/
+	int size() const;
+
+	/*
+		Return the number of duplicates rejected
+	*/
+	int getNumDuplicates() const;
+
+	/*
+		Return the share of distinct schedules among the last window candidates
+	*/
+	double getDiversity() const;
+
+	/*
+		Return true if the diversity dropped below the threshold,
+		i.e. new individuals should be immigrants or the search should restart
+	*/
+	bool isStagnating() const;
+
+private:
+	std::vector<unsigned long> _table; // 0 marks an empty slot
+	std::vector<bool> _history;        // Circular buffer: was the candidate distinct?
+	int _size,
+	    _numDuplicates,
+	    _numCandidates,
+	    _numDistinct;                  // Number of distinct candidates in the history
+	double _threshold;
+
+	void grow();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline int HashSet::size() const
+{
+	return _size;
+}
+
+inline int HashSet::getNumDuplicates() const
+{
+	return _numDuplicates;
+}
+
+inline bool HashSet::isStagnating() const
+{
+	return _numCandidates >= (int)_history.size() && getDiversity() < _threshold;
+}
+
+#endif
@@ -89,6 +89,11 @@ public:
 	*/
 	void addSuccessor( Job * s );
 
+	/*
+		Remove all the predecessors and successors
+	*/
+	void clearPrecedences();
+
 private:
 	int _id, _duration, _start, _finish;
 	std::vector<int> _request;
@@ -160,4 +165,10 @@ inline void Job::addSuccessor( Job * s )
 	_successors.push_back( s );
 }
 
+inline void Job::clearPrecedences()
+{
+	_predecessors.clear();
+	_successors.clear();
+}
+
 #endif
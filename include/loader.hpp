@@ -0,0 +1,28 @@
+#ifndef LOADER_HPP
+#define LOADER_HPP
+
+#include "problem.hpp"
+#include <string>
+
+/*
+	Loader of the instance files, whatever their format: compiled instances
+	(see binary), Patterson instances (they start with a number) and PSPLIB
+	instances.
+*/
+struct loader
+{
+	/*
+		Load the problem from a file, or from its cache if it is fresh (see
+		binary), return false if it cannot be read (a malformed instance
+		throws std::runtime_error)
+	*/
+	static bool load( const std::string & filename, Problem & p );
+
+	/*
+		Parse the problem from a text buffer in the format detected, return the
+		end of the instance
+	*/
+	static const char * parse( const char * begin, const char * end, Problem & p );
+};
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef MAPPEDFILE_HPP
+#define MAPPEDFILE_HPP
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+/*
+	A read-only file mapped in memory.
+	Files which cannot be mapped (pipes, special files) are read in a buffer.
+*/
+class MappedFile
+{
+public:
+	MappedFile();
+	~MappedFile();
+
+	/*
+		Map the file, return false if it cannot be read
+	*/
+	bool open( const std::string & filename );
+
+	/*
+		Unmap the file
+	*/
+	void close();
+
+	/*
+		Return the first byte of the file
+	*/
+	const char * begin() const;
+
+	/*
+		Return the byte after the last one of the file
+	*/
+	const char * end() const;
+
+	/*
+		Return the size of the file in bytes
+	*/
+	std::size_t size() const;
+
+private:
+	const char * _data;
+	std::size_t _size;
+	bool _mapped;             // The data is mapped (otherwise it is in the buffer)
+	std::vector<char> _buffer;
+
+	// Not copyable
+	MappedFile( const MappedFile & );
+	MappedFile & operator = ( const MappedFile & );
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline const char * MappedFile::begin() const
+{
+	return _data;
+}
+
+inline const char * MappedFile::end() const
+{
+	return _data + _size;
+}
+
+inline std::size_t MappedFile::size() const
+{
+	return _size;
+}
+
+#endif
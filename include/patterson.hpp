@@ -0,0 +1,21 @@
+#ifndef PATTERSON_HPP
+#define PATTERSON_HPP
+
+#include "problem.hpp"
+
+/*
+	Reader of the Patterson instances (.rcp files, e.g. the RG300 set).
+	The file is a sequence of numbers: the numbers of jobs and resources,
+	the capacities, then for each job its duration, its requests, its number
+	of successors and the successors. The numbers are scanned directly from
+	the buffer.
+*/
+struct patterson
+{
+	/*
+		Parse the problem from a buffer, return the end of the instance
+	*/
+	static const char * parse( const char * begin, const char * end, Problem & p );
+};
+
+#endif
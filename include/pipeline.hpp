@@ -0,0 +1,84 @@
+#ifndef PIPELINE_HPP
+#define PIPELINE_HPP
+
+#include "problem.hpp"
+#include <string>
+#include <iostream>
+#include <pthread.h>
+
+class ReaderTask;
+
+/*
+	Solve the instances of a stream of concatenated PSPLIB instances.
+	A reader thread extracts and preprocesses the next instance while the
+	current one is solved; the two problems are used in turn. One CSV line
+	(instance number, lower bound, makespan, time, schedules) is written per
+	instance.
+*/
+class Pipeline
+{
+public:
+	Pipeline( std::istream & is );
+	~Pipeline();
+
+	/*
+		Set the number of threads of the parallel engines (0 means one per processor)
+	*/
+	void setNumThreads( int n );
+
+	/*
+		Set the random seed: the instance i (from 0) is solved with seed+i
+	*/
+	void setSeed( unsigned int seed );
+
+	/*
+		Solve the instances until the end of the stream, write the results to os
+	*/
+	void run( std::ostream & os );
+
+private:
+	friend class ReaderTask;
+
+	// State of a problem
+	enum
+	{
+		Free,   // Can be overwritten by the reader
+		Ready,  // Read, to be solved
+		Invalid // Malformed, to be reported
+	};
+
+	std::istream & _is;
+	int _numThreads;
+	unsigned int _seed;
+
+	Problem _problems[2];
+	int _state[2];
+	std::string _error[2];
+	bool _end;              // No more instance will be read
+
+	pthread_mutex_t _mutex;
+	pthread_cond_t _changed;
+
+	/*
+		Read the instances of the stream (called by the reader thread)
+	*/
+	void read();
+
+	// Not copyable
+	Pipeline( const Pipeline & );
+	Pipeline & operator = ( const Pipeline & );
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline void Pipeline::setNumThreads( int n )
+{
+	_numThreads = n;
+}
+
+inline void Pipeline::setSeed( unsigned int seed )
+{
+	_seed = seed;
+}
+
+#endif
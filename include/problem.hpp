@@ -49,6 +49,77 @@ public:
 	*/
 	int getUpperBound() const;
 
+	/*
+		Return the makespan of a serial SGS schedule with the latest finish time rule,
+		a cheap upper bound of Cmax
+	*/
+	int getHeuristicBound() const;
+
+	/*
+		Return the critical path lower bound of Cmax (longest path in the precedence graph)
+	*/
+	int getCriticalPathBound() const;
+
+	/*
+		Return the resource lower bound of Cmax (max over k of the total energy divided by the capacity)
+	*/
+	int getResourceBound() const;
+
+	/*
+		Return the energetic reasoning lower bound of Cmax (smallest Cmax for which
+		no time interval needs more energy than available)
+	*/
+	int getEnergeticBound() const;
+
+	/*
+		Return the node packing lower bound of Cmax (total duration of a set of
+		pairwise incompatible jobs, which cannot overlap)
+	*/
+	int getNodePackingBound() const;
+
+	/*
+		Return the time-table lower bound of Cmax (smallest Cmax for which the
+		constraint propagation on the time windows does not fail)
+	*/
+	int getTimetableBound() const;
+
+	/*
+		Return the best lower bound of Cmax
+	*/
+	int getLowerBound() const;
+
+	/*
+		Return the earliest start time of the job j (CPM forward pass)
+	*/
+	int getJobEarliestStart( int j ) const;
+
+	/*
+		Return the latest start time of the job j for a makespan cmax (CPM backward pass,
+		tightened by constraint propagation when cmax is at most the heuristic bound)
+	*/
+	int getJobLatestStart( int j, int cmax ) const;
+
+	/*
+		Return the tail of the job j (longest path from its end to the end of the project)
+	*/
+	int getJobTail( int j ) const;
+
+	/*
+		Return true if the job i is a (transitive) predecessor of the job j
+	*/
+	bool isJobPredecessor( int i, int j ) const;
+
+	/*
+		Return the jobs in a topological order of the precedence graph
+	*/
+	const std::vector<int> & getTopologicalOrder() const;
+
+	/*
+		Compute the time windows, the transitive closure of the precedences and
+		the lower bounds (done when the problem is loaded, call it after any change)
+	*/
+	void preprocess();
+
 	/*
 		Return the predecessors of the job j
 	*/
@@ -60,12 +131,12 @@ public:
 	const std::vector<int> & getJobSuccessors( int j ) const;
 
 	/*
-		Set the number of jobs (allocate jmax jobs)
+		Set the number of jobs (allocate jmax jobs, without duration, request nor precedence)
 	*/
 	void setNumJobs( int jmax );
 
 	/*
-		Set the number of resources (allocate rmax resources)
+		Set the number of resources (allocate rmax resources, the requests are cleared)
 	*/
 	void setNumResources( int rmax );
 
@@ -104,13 +175,19 @@ public:
 	*/
 	void exportDotPrecedenceGraph( std::ostream & os ) const;
 
-	// Instance value reader
-	static int readValue( const std::string & line );
-
 private:
+	// Compiled instances restore the preprocessed data
+	friend struct binary;
+
 	int _numJobs,
 	    _numResources,
-	    _horizon;
+	    _horizon,
+	    _criticalPathBound,
+	    _resourceBound,
+	    _energeticBound,
+	    _nodePackingBound,
+	    _timetableBound,
+	    _heuristicBound;
 
 	std::vector<int> _resourceCapacity,
 	                 _jobDuration;
@@ -118,6 +195,55 @@ private:
 	std::vector< std::vector<int> > _jobRequest,
 	                                _jobPredecessors,
 	                                _jobSuccessors;
+
+	std::vector<int> _topologicalOrder,
+	                 _jobHead, // Length of the longest path from the beginning to the start of j
+	                 _jobTail, // Length of the longest path from the end of j to the end
+	                 _jobLatestStart; // Latest start time of j for the heuristic bound after propagation
+
+	std::vector<unsigned long> _closure; // Row j: bit set of the transitive successors of j
+	int _closureWords;                   // Number of words per row
+
+	/*
+		Compute the topological order, the heads and the tails
+	*/
+	void computeWindows();
+
+	/*
+		Compute the transitive closure, one word-parallel OR per arc in reverse topological order
+	*/
+	void computeClosure();
+
+	/*
+		Compute the lower bounds, one after the other (the instances of a batch
+		are already solved in parallel)
+	*/
+	void computeBounds();
+
+	/*
+		Energetic reasoning test: is there an interval needing more energy than available with makespan T?
+	*/
+	bool isEnergyFeasible( int T ) const;
+
+	/*
+		Compute the heuristic upper bound (tails must be computed)
+	*/
+	int computeHeuristicBound() const;
+
+	/*
+		Compute the energetic reasoning bound (heads and tails must be computed)
+	*/
+	int computeEnergeticBound() const;
+
+	/*
+		Compute the node packing bound
+	*/
+	int computeNodePackingBound() const;
+
+	/*
+		Compute the time-table bound (heads, tails and the heuristic bound must be computed)
+	*/
+	int computeTimetableBound() const;
 };
 
 /*
@@ -126,7 +252,7 @@ private:
 std::ostream & operator << ( std::ostream & os, const Problem & p );
 
 /*
-	Load the problem from an input stream
+	Load the next problem of an input stream (the failbit is set if there is none)
 */
 std::istream & operator >> ( std::istream & is, Problem & p );
 
@@ -162,6 +288,71 @@ inline int Problem::getResourceCapacity( int k ) const
 	return _resourceCapacity[k];
 }
 
+inline int Problem::getHeuristicBound() const
+{
+	return _heuristicBound;
+}
+
+inline int Problem::getCriticalPathBound() const
+{
+	return _criticalPathBound;
+}
+
+inline int Problem::getResourceBound() const
+{
+	return _resourceBound;
+}
+
+inline int Problem::getEnergeticBound() const
+{
+	return _energeticBound;
+}
+
+inline int Problem::getNodePackingBound() const
+{
+	return _nodePackingBound;
+}
+
+inline int Problem::getTimetableBound() const
+{
+	return _timetableBound;
+}
+
+inline int Problem::getLowerBound() const
+{
+	return std::max( std::max( std::max( _criticalPathBound, _resourceBound ), std::max( _energeticBound, _nodePackingBound ) ), _timetableBound );
+}
+
+inline int Problem::getJobEarliestStart( int j ) const
+{
+	return _jobHead[j];
+}
+
+inline int Problem::getJobLatestStart( int j, int cmax ) const
+{
+	// The propagation for a makespan holds for smaller ones, shifted
+	if ( cmax <= _heuristicBound && !_jobLatestStart.empty() )
+		return _jobLatestStart[j] - ( _heuristicBound - cmax );
+
+	return cmax - _jobTail[j] - _jobDuration[j];
+}
+
+inline int Problem::getJobTail( int j ) const
+{
+	return _jobTail[j];
+}
+
+inline bool Problem::isJobPredecessor( int i, int j ) const
+{
+	const int bits = 8 * sizeof( unsigned long );
+	return ( _closure[i * _closureWords + j / bits] >> ( j % bits ) ) & 1UL;
+}
+
+inline const std::vector<int> & Problem::getTopologicalOrder() const
+{
+	return _topologicalOrder;
+}
+
 inline const std::vector<int> & Problem::getJobPredecessors( int j ) const
 {
 	return _jobPredecessors[j];
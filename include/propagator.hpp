@@ -0,0 +1,149 @@
+#ifndef PROPAGATOR_HPP
+#define PROPAGATOR_HPP
+
+#include "problem.hpp"
+#include <vector>
+
+/*
+	Constraint propagation on the time windows [ES,LS] of the jobs for a
+	makespan at most a deadline.
+	The resource profiles hold the compulsory parts of the jobs (the periods
+	[LS,ES+d) a job covers wherever it starts in its window). The windows are
+	tightened until a fixpoint:
+	- precedences: ES(s) >= ES(j) + d(j) and LS(j) <= LS(s) - d(j);
+	- time-table: a job cannot start where the compulsory parts of the other
+	  jobs leave it too little capacity.
+	The changes are driven by event queues (windows to propagate along the
+	precedences, jobs to filter against a modified profile), and recorded in
+	a trail to be undone when a search backtracks.
+*/
+class Propagator
+{
+public:
+	Propagator( const Problem & p );
+
+	/*
+		Reset the windows from the heads and tails for the deadline, then propagate.
+		Return false if no schedule can end by the deadline
+	*/
+	bool initialize( int deadline );
+
+	/*
+		Fix the start time of the job j, then propagate.
+		Return false if no schedule can end by the deadline
+	*/
+	bool setStartTime( int j, int t );
+
+	/*
+		Raise the earliest start time of the job j, then propagate.
+		Return false if no schedule can end by the deadline
+	*/
+	bool setEarliestStart( int j, int t );
+
+	/*
+		Return a mark of the current windows (see undo)
+	*/
+	int getMark() const;
+
+	/*
+		Restore the windows of a mark
+	*/
+	void undo( int mark );
+
+	/*
+		Return the deadline
+	*/
+	int getDeadline() const;
+
+	/*
+		Return the earliest start time of the job j
+	*/
+	int getEarliestStart( int j ) const;
+
+	/*
+		Return the latest start time of the job j
+	*/
+	int getLatestStart( int j ) const;
+
+private:
+	const Problem & _problem;
+
+	int _numJobs,
+	    _numResources,
+	    _deadline;
+
+	std::vector<int> _est,
+	                 _lst,
+	                 _profile; // profile[t*R+k] is the compulsory usage of the resource k at period t
+
+	// Event queues
+	std::vector<int> _precedenceQueue, // Jobs whose window changed
+	                 _timetableQueue;  // Jobs to filter against the profile
+	std::vector<char> _precedenceQueued,
+	                  _timetableQueued;
+
+	// Trail of the former windows
+	std::vector<int> _trailJob,
+	                 _trailEst,
+	                 _trailLst;
+
+	/*
+		Intersect the window of the job j with [est,lst], and queue the events.
+		Return false if the window becomes empty
+	*/
+	bool tighten( int j, int est, int lst );
+
+	/*
+		Process the events until a fixpoint. Return false if a window becomes empty
+	*/
+	bool propagate();
+
+	/*
+		Time-table filtering of the window of the job j. Return false if it becomes empty
+	*/
+	bool filter( int j );
+
+	/*
+		Return true if the job j fits in the profile at period u (without its own compulsory part)
+	*/
+	bool fits( int j, int u ) const;
+
+	/*
+		Add (sign 1) or remove (sign -1) the compulsory part of j with the window [est,lst]
+	*/
+	void addCompulsoryPart( int j, int est, int lst, int sign );
+
+	/*
+		Queue the jobs whose window meets [a,b) for time-table filtering, except j
+	*/
+	void queueOverlapping( int j, int a, int b );
+
+	/*
+		Empty the event queues
+	*/
+	void clearQueues();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline int Propagator::getMark() const
+{
+	return _trailJob.size();
+}
+
+inline int Propagator::getDeadline() const
+{
+	return _deadline;
+}
+
+inline int Propagator::getEarliestStart( int j ) const
+{
+	return _est[j];
+}
+
+inline int Propagator::getLatestStart( int j ) const
+{
+	return _lst[j];
+}
+
+#endif
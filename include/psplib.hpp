@@ -0,0 +1,34 @@
+#ifndef PSPLIB_HPP
+#define PSPLIB_HPP
+
+#include "problem.hpp"
+#include <string>
+#include <istream>
+#include <ostream>
+
+/*
+	Reader of the PSPLIB single-mode instances (.sm files).
+	The numbers are scanned directly from the buffer (a file is mapped in
+	memory by the loader): the labels are only used to find the sections.
+*/
+struct psplib
+{
+	/*
+		Parse the problem from a buffer, return the end of the instance
+	*/
+	static const char * parse( const char * begin, const char * end, Problem & p );
+
+	/*
+		Extract the text of the next instance of a stream of concatenated
+		instances (up to the banner line after the resource availabilities),
+		return false if the stream has no more instance
+	*/
+	static bool extract( std::istream & is, std::string & text );
+
+	/*
+		Write the problem in the PSPLIB format
+	*/
+	static void write( std::ostream & os, const Problem & p );
+};
+
+#endif
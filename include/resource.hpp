@@ -15,7 +15,7 @@ public:
 	Resource( int tmax, int rmax );
 
 	/*
-		Reset all the variables in the resource
+		Reset all the variables in the resource (the periods are cleared in place)
 	*/
 	void reset();
 
@@ -41,6 +41,7 @@ public:
 
 	/*
 		Return the leftmost period for which we can allocate req*duration squares
+		(it may end after the maximal time, where all the squares are free)
 	*/
 	int findSpace( int t, int req, int duration ) const;
 
@@ -49,11 +50,21 @@ public:
 	*/
 	void assign( int t, int req, int duration, int j );
 
+	/*
+		Remove a job from the resource scheduling (frees the req squares owned by j)
+	*/
+	void unassign( int t, int req, int duration, int j );
+
 	/*
 		Allocate a period interval [0,tmax-1]
 	*/
 	void setMaxTime( int tmax );
 
+	/*
+		Change the period interval to [0,tmax-1], keeping the usage of the remaining periods
+	*/
+	void resizeTime( int tmax );
+
 	/*
 		Allocate a resource usage interval [0,rmax-1]
 	*/
@@ -65,7 +76,8 @@ public:
 	void setUsage( int t, int r, int j );
 
 	/*
-		Allocate the period interval [0,tmax-1] and the resource usage interval [0,rmax-1]
+		Allocate the period interval [0,tmax-1] and the resource usage interval [0,rmax-1],
+		all free (the periods of the same capacity are reused)
 	*/
 	void resize( int tmax, int rmax );
 
@@ -87,11 +99,6 @@ std::ostream & operator << ( std::ostream & os, const Resource & s );
 
 ////////////////////////////////////////////////////////////////////////////////
 
-inline void Resource::reset()
-{
-	resize( getMaxTime(), getCapacity() );
-}
-
 inline int Resource::getMaxTime() const
 {
 	return _use.size();
@@ -122,10 +129,4 @@ inline void Resource::setUsage( int t, int r, int j )
 	_use[t][r] = j;
 }
 
-inline void Resource::resize( int tmax, int rmax )
-{
-	_use.clear();
-	_use.resize( tmax, std::vector<int>( rmax ) );
-}
-
 #endif
@@ -0,0 +1,101 @@
+#ifndef SCANNER_HPP
+#define SCANNER_HPP
+
+#include <stdexcept>
+
+/*
+	A forward scanner of the numbers of a text buffer.
+	The text around the numbers (labels, separators) is skipped, only the
+	section titles are searched.
+*/
+class Scanner
+{
+public:
+	Scanner( const char * begin, const char * end );
+
+	/*
+		Move after the next occurrence of label, return false if there is none
+		(the scanner is then at the end)
+	*/
+	bool find( const char * label );
+
+	/*
+		Move to the beginning of the next line
+	*/
+	void skipLine();
+
+	/*
+		Read the next integer (the characters before it are skipped)
+	*/
+	int readInt();
+
+	/*
+		Read the integer after the next colon
+	*/
+	int readValue();
+
+	/*
+		Return the current position
+	*/
+	const char * getPosition() const;
+
+	/*
+		Return true if the whole buffer is scanned
+	*/
+	bool isAtEnd() const;
+
+private:
+	const char * _position,
+	           * _end;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline Scanner::Scanner( const char * begin, const char * end ) :
+	_position( begin ),
+	_end( end )
+{
+}
+
+inline void Scanner::skipLine()
+{
+	while ( _position < _end && *_position++ != '\n' );
+}
+
+inline int Scanner::readInt()
+{
+	bool negative( false );
+	int value( 0 );
+
+	while ( _position < _end && ( *_position < '0' || *_position > '9' ) )
+	{
+		negative = ( *_position == '-' );
+		++_position;
+	}
+
+	if ( _position == _end )
+		throw std::runtime_error( "Unexpected end of the instance" );
+
+	while ( _position < _end && *_position >= '0' && *_position <= '9' )
+		value = 10 * value + ( *_position++ - '0' );
+
+	return negative ? -value : value;
+}
+
+inline int Scanner::readValue()
+{
+	while ( _position < _end && *_position++ != ':' );
+	return readInt();
+}
+
+inline const char * Scanner::getPosition() const
+{
+	return _position;
+}
+
+inline bool Scanner::isAtEnd() const
+{
+	return _position == _end;
+}
+
+#endif
@@ -0,0 +1,182 @@
+#ifndef SCATTER_HPP
+#define SCATTER_HPP
+
+#include "problem.hpp"
+#include "solution.hpp"
+#include "threadpool.hpp"
+#include "archive.hpp"
+#include "budget.hpp"
+#include <vector>
+
+class CombinationTask;
+
+/*
+	A scatter search on activity lists.
+	The reference set holds the best and the most diverse lists built by
+	GRASP. Every pair of the reference set with at least one new list is
+	combined with a two-point precedence-preserving crossover and improved
+	with a local search; the pairs are processed in parallel on a thread pool.
+*/
+class ScatterSearch
+{
+public:
+	ScatterSearch( const Problem & p );
+	~ScatterSearch();
+
+	/*
+		Set the number of lists kept for their quality and for their diversity
+	*/
+	void setRefSetSize( int quality, int diversity );
+
+	/*
+		Set the number of GRASP lists the reference set is chosen from
+	*/
+	void setPopulationSize( int n );
+
+	/*
+		Set the alpha parameter of GRASP
+	*/
+	void setAlpha( double alpha );
+
+	/*
+		Set the improvement method (see Solution::localSearch), first improvement by default
+	*/
+	void setLocalSearch( int strategy, int moves );
+
+	/*
+		Set the number of combination rounds
+	*/
+	void setMaxIterations( int n );
+
+	/*
+		Set the number of threads combining pairs (0 means one per processor)
+	*/
+	void setNumThreads( int n );
+
+	/*
+		Set the archive shared with the other solvers (0 means none): the
+		children are published there from the worker threads, and its elite
+		lists are candidates when the reference set is rebuilt
+	*/
+	void setArchive( Archive * archive );
+
+	/*
+		Set the shared stopping criteria (0 means none)
+	*/
+	void setBudget( Budget * budget );
+
+	/*
+		Set the seed of the GRASP lists and of the combinations
+	*/
+	void setSeed( unsigned int seed );
+
+	/*
+		Run the search, s ends up being the best solution found
+	*/
+	void solve( Solution & s );
+
+	/*
+		Return the number of schedules evaluated by the last search
+	*/
+	int getNumEvaluations() const;
+
+private:
+	const Problem & _problem;
+
+	int _quality,
+	    _diversity,
+	    _populationSize,
+	    _strategy,
+	    _moves,
+	    _maxIterations,
+	    _numThreads,
+	    _numEvaluations;
+
+	double _alpha;
+
+	Archive * _archive;
+	Budget * _budget;
+	unsigned int _seed;
+
+	std::vector< std::vector<int> > _refSet;
+	std::vector<int> _refCmax;
+	std::vector<bool> _refNew;
+
+	std::vector<CombinationTask *> _tasks; // One workspace per pair, reused between rounds
+
+	/*
+		Build the reference set from new GRASP lists, keeping the first
+		quality lists already in the reference set
+	*/
+	void diversify( int quality );
+
+	/*
+		Try to insert a list in the reference set (in place of the worst one when full)
+	*/
+	bool insert( const std::vector<int> & sequence, int cmax );
+
+	/*
+		Return the distance between a list and the closest reference list
+	*/
+	int getMinDistance( const std::vector<int> & sequence ) const;
+
+	// Not copyable
+	ScatterSearch( const ScatterSearch & );
+	ScatterSearch & operator = ( const ScatterSearch & );
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline void ScatterSearch::setRefSetSize( int quality, int diversity )
+{
+	_quality = quality;
+	_diversity = diversity;
+}
+
+inline void ScatterSearch::setPopulationSize( int n )
+{
+	_populationSize = n;
+}
+
+inline void ScatterSearch::setAlpha( double alpha )
+{
+	_alpha = alpha;
+}
+
+inline void ScatterSearch::setLocalSearch( int strategy, int moves )
+{
+	_strategy = strategy;
+	_moves = moves;
+}
+
+inline void ScatterSearch::setMaxIterations( int n )
+{
+	_maxIterations = n;
+}
+
+inline void ScatterSearch::setNumThreads( int n )
+{
+	_numThreads = n;
+}
+
+inline void ScatterSearch::setArchive( Archive * archive )
+{
+	_archive = archive;
+}
+
+inline void ScatterSearch::setBudget( Budget * budget )
+{
+	_budget = budget;
+}
+
+inline void ScatterSearch::setSeed( unsigned int seed )
+{
+	_seed = seed;
+}
+
+inline int ScatterSearch::getNumEvaluations() const
+{
+	return _numEvaluations;
+}
+
+#endif
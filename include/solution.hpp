@@ -6,6 +6,7 @@
 #include "resource.hpp"
 #include <vector>
 #include <iostream>
+#include <limits>
 
 /*
 	A class to handle a solution, i.e. a list of jobs.
@@ -19,6 +20,13 @@ public:
 	Solution( const Solution & s );
 	virtual ~Solution();
 
+	// Local search strategies
+	enum
+	{
+		FirstImprovement = 1,
+		BestImprovement  = 2
+	};
+
 	/*
 		Set the problem of the solution
 	*/
@@ -34,15 +42,50 @@ public:
 	*/
 	int getCmax() const;
 
+	/*
+		Get a hash of the start times, equal for lists decoding to the same schedule
+	*/
+	unsigned long getScheduleHash() const;
+
 	/*
 		Get the minimum start time possible for job j
 	*/
 	int getMinStartTimeOfJob( int j ) const;
 
 	/*
-		Build a solution with GRASP procedure
+		Build a solution with GRASP procedure, drawing from the random state seed
+	*/
+	void grasp( double alpha, unsigned int & seed );
+
+	/*
+		Improve the solution with insertion moves (adjacent swaps included)
+		until a local optimum is reached or budget moves have been evaluated.
+		Return the number of moves evaluated.
+	*/
+	int localSearch( int strategy, int budget );
+
+	/*
+		Walk from the solution toward the guiding list (a feasible list of the
+		same problem) and keep the best intermediate solution of the path.
+		Return the number of intermediate solutions evaluated.
+	*/
+	int relink( const std::vector<int> & guide );
+
+	/*
+		Get the range of positions [lo,hi] where the job at position i can be
+		moved without breaking precedence constraints
 	*/
-	void grasp( double alpha );
+	void getMoveWindow( int i, int & lo, int & hi ) const;
+
+	/*
+		Move the job at position i to position k (jobs between are shifted)
+	*/
+	void move( int i, int k );
+
+	/*
+		Get the position of the job j in the solution
+	*/
+	int getPosition( int j ) const;
 
 	/*
 		Get the source job
@@ -69,6 +112,16 @@ public:
 	*/
 	int & operator [] ( int i );
 
+	/*
+		Replace the list of job ids and update the solution
+	*/
+	void setSequence( const std::vector<int> & sequence );
+
+	/*
+		Get the list of job ids
+	*/
+	const std::vector<int> & getSequence() const;
+
 	/*
 		Get the size of the solution
 	*/
@@ -79,6 +132,36 @@ public:
 	*/
 	void update();
 
+	/*
+		Update variables of the solution from position i to the end
+		(positions before i must be unchanged since the last update)
+	*/
+	void update( int i );
+
+	/*
+		Same as update( i ), but give up as soon as a job finishes after cutoff.
+		Return false if the decoding was abandoned (Cmax is then meaningless).
+	*/
+	bool update( int i, int cutoff );
+
+	/*
+		Undo move( i, k ) and the update( min(i,k) ) or update( min(i,k), cutoff )
+		that followed: the job goes back to position i and the jobs of the tail
+		get their former start times again, without decoding
+	*/
+	void undo( int i, int k );
+
+	/*
+		Get the number of periods of the resource tables
+	*/
+	int getMaxTime() const;
+
+	/*
+		Release the periods of the resource tables after tmax (and after Cmax),
+		e.g. when a better incumbent makes longer schedules useless
+	*/
+	void shrink( int tmax );
+
 	/*
 		Show the resource usage with gnuplot
 	*/
@@ -105,11 +188,26 @@ public:
 	void clear();
 
 private:
+	const Problem * _problem;
 	std::vector<int> _sequence; // The solution
+	std::vector<int> _position; // position[j] is the index of the job j in the sequence
+	std::vector<int> _saved;    // saved[j] is the start time of the job j before the last update of the tail
+	int _decoded;               // Positions scheduled by the last decoding (the tail ends there if it was abandoned)
 	std::vector<Job *> _jobs;   // Array of jobs
 	std::vector<Resource> _resources;   // Array of resources
 
 	void sortByUtility( std::vector<int> & RCL, std::vector<int> & u ) const;
+
+	/*
+		Schedule the jobs from position i to the end on the resources,
+		return false if a job starts too late to finish the project by cutoff
+	*/
+	bool decode( int i, int cutoff = std::numeric_limits<int>::max() );
+
+	/*
+		Resize the resource tables to tmax periods (the tables grow when a job overruns them)
+	*/
+	void setMaxTime( int tmax );
 };
 
 std::ostream & operator << ( std::ostream & os, const Solution & s );
@@ -136,6 +234,11 @@ inline Job * Solution::getJobAt( int j ) const
 	return _jobs[_sequence[j]];
 }
 
+inline int Solution::getPosition( int j ) const
+{
+	return _position[j];
+}
+
 inline int Solution::operator [] ( int i ) const
 {
 	return _sequence[i];
@@ -146,6 +249,11 @@ inline int & Solution::operator [] ( int i )
 	return _sequence[i];
 }
 
+inline const std::vector<int> & Solution::getSequence() const
+{
+	return _sequence;
+}
+
 inline int Solution::size() const
 {
 	return _sequence.size();
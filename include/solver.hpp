@@ -0,0 +1,118 @@
+#ifndef SOLVER_HPP
+#define SOLVER_HPP
+
+#include "problem.hpp"
+#include "solution.hpp"
+#include "budget.hpp"
+#include <iostream>
+
+/*
+	The solving procedure of an instance, configured by the arguments: a
+	population built with GRASP, then the best solution improved by the
+	chosen engine.
+	A solver can be reused from an instance to the next: its solutions keep
+	their allocations when the problems have the same size.
+*/
+class Solver
+{
+public:
+	Solver();
+
+	/*
+		Set the number of threads of the parallel engines (0 means one per processor)
+	*/
+	void setNumThreads( int n );
+
+	/*
+		Set the stream the engines write their summary to (0 means none)
+	*/
+	void setSummary( std::ostream * os );
+
+	/*
+		Set the seed of the random numbers: every solve starts again from it,
+		so that its result does not depend on the other solvers
+	*/
+	void setSeed( unsigned int seed );
+
+	/*
+		Solve the problem p; the stopping criteria of the budget are set from
+		the arguments (the target is raised to the lower bound of p)
+	*/
+	void solve( const Problem & p, Budget & budget );
+
+	/*
+		Return the best solution of the last problem solved
+	*/
+	const Solution & getBest() const;
+
+	/*
+		Return the best makespan of the last problem solved
+	*/
+	int getBestCmax() const;
+
+	/*
+		Return the lower bound of the last problem solved (raised by a proof
+		of the exact engine)
+	*/
+	int getLowerBound() const;
+
+	/*
+		Return the number of duplicate schedules rejected from the population
+	*/
+	int getNumDuplicates() const;
+
+private:
+	int _numThreads,
+	    _bestCmax,
+	    _lowerBound,
+	    _numDuplicates;
+
+	std::ostream * _summary;
+	unsigned int _seed;
+
+	Solution _solution,                // Working solution of GRASP
+	         _best;
+
+	// Not copyable
+	Solver( const Solver & );
+	Solver & operator = ( const Solver & );
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline void Solver::setNumThreads( int n )
+{
+	_numThreads = n;
+}
+
+inline void Solver::setSummary( std::ostream * os )
+{
+	_summary = os;
+}
+
+inline void Solver::setSeed( unsigned int seed )
+{
+	_seed = seed;
+}
+
+inline const Solution & Solver::getBest() const
+{
+	return _best;
+}
+
+inline int Solver::getBestCmax() const
+{
+	return _bestCmax;
+}
+
+inline int Solver::getLowerBound() const
+{
+	return _lowerBound;
+}
+
+inline int Solver::getNumDuplicates() const
+{
+	return _numDuplicates;
+}
+
+#endif
@@ -0,0 +1,75 @@
+#ifndef STATS_HPP
+#define STATS_HPP
+
+#include <iostream>
+
+/*
+	Instrumentation of the hot paths, compiled in with -DSTATS=1 (make STATS=1).
+	Each thread counts in its own counters, merged into the totals when it
+	ends; the phases are timed exclusively (a nested phase pauses the outer
+	one). Compiled out, the macros expand to nothing.
+*/
+struct stats
+{
+	// Counters
+	enum
+	{
+		Decodes,          // Serial schedule generations (complete or incremental)
+		FindSpace,        // Searches of a space in a resource table
+		PeriodsScanned,   // Periods examined by these searches
+		Assignments,      // Jobs assigned to a resource table
+		GraspSteps,       // Jobs appended to a list by GRASP
+		GraspCandidates,  // Eligible jobs examined at these steps
+		CacheHits,        // Instances loaded from a compiled cache
+		Allocations,      // Job objects allocated and resource tables grown
+		NumCounters
+	};
+
+	// Phases
+	enum
+	{
+		None,
+		Parse,            // Reading of the instances
+		Init,             // Preprocessing (time windows, bounds)
+		Search,           // Solving
+		Export,           // Writing of the results
+		NumPhases
+	};
+
+	/*
+		Add n to a counter of the calling thread
+	*/
+	static void count( int counter, long n );
+
+	/*
+		Time a phase in the calling thread from the construction to the destruction
+	*/
+	class PhaseTimer
+	{
+	public:
+		PhaseTimer( int phase );
+		~PhaseTimer();
+
+	private:
+		int _previous;
+	};
+
+	/*
+		Write the totals (the calling thread and the ended ones)
+	*/
+	static void report( std::ostream & os );
+};
+
+#ifndef STATS
+#define STATS 0
+#endif
+
+#if STATS
+#define STATS_COUNT( counter, n ) stats::count( stats::counter, n )
+#define STATS_PHASE( phase ) stats::PhaseTimer statsPhaseTimer( stats::phase )
+#else
+#define STATS_COUNT( counter, n )
+#define STATS_PHASE( phase )
+#endif
+
+#endif
@@ -0,0 +1,132 @@
+#ifndef TABU_HPP
+#define TABU_HPP
+
+#include "problem.hpp"
+#include "solution.hpp"
+#include "archive.hpp"
+#include "budget.hpp"
+#include <vector>
+
+/*
+	A tabu search on activity lists.
+	Moves are insertions of a job at another position of the list. The
+	attribute (job, position) left by a move is tabu for a few iterations,
+	unless the move leads to a new best makespan (aspiration).
+*/
+class TabuSearch
+{
+public:
+	TabuSearch( const Problem & p );
+
+	/*
+		Set the number of iterations a (job, position) attribute stays tabu
+	*/
+	void setTenure( int tenure );
+
+	/*
+		Set the number of moves sampled at each iteration
+	*/
+	void setSampleSize( int n );
+
+	/*
+		Set the number of iterations of the search
+	*/
+	void setMaxIterations( int n );
+
+	/*
+		Set the archive where the new best solutions are published (0 means none)
+	*/
+	void setArchive( Archive * archive );
+
+	/*
+		Set the shared stopping criteria (0 means none)
+	*/
+	void setBudget( Budget * budget );
+
+	/*
+		Set the seed of the random moves
+	*/
+	void setSeed( unsigned int seed );
+
+	/*
+		Improve the solution s, which ends up being the best solution found
+	*/
+	void solve( Solution & s );
+
+	/*
+		Return the number of schedules evaluated by the last search
+	*/
+	int getNumEvaluations() const;
+
+private:
+	int _tenure,
+	    _sampleSize,
+	    _maxIterations,
+	    _numEvaluations;
+
+	Archive * _archive;
+	Budget * _budget;
+	unsigned int _seed;
+
+	// Attribute left by a move: the job cannot go back to the position until the expiry iteration
+	struct Attribute
+	{
+		int job,
+		    position,
+		    expiry;
+	};
+
+	std::vector<Attribute> _tabu; // Attributes of the last tenure moves (ring buffer)
+	int _last;                    // Position of the latest attribute in the ring
+
+	bool isTabu( int j, int i, int iteration ) const;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline void TabuSearch::setTenure( int tenure )
+{
+	_tenure = tenure;
+}
+
+inline void TabuSearch::setSampleSize( int n )
+{
+	_sampleSize = n;
+}
+
+inline void TabuSearch::setMaxIterations( int n )
+{
+	_maxIterations = n;
+}
+
+inline void TabuSearch::setArchive( Archive * archive )
+{
+	_archive = archive;
+}
+
+inline void TabuSearch::setBudget( Budget * budget )
+{
+	_budget = budget;
+}
+
+inline int TabuSearch::getNumEvaluations() const
+{
+	return _numEvaluations;
+}
+
+inline bool TabuSearch::isTabu( int j, int i, int iteration ) const
+{
+	for ( int a = 0; a < (int)_tabu.size(); ++a )
+	{
+		if ( _tabu[a].job == j && _tabu[a].position == i && _tabu[a].expiry >= iteration )
+			return true;
+	}
+	return false;
+}
+
+inline void TabuSearch::setSeed( unsigned int seed )
+{
+	_seed = seed;
+}
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+#include <vector>
+#include <deque>
+#include <pthread.h>
+
+/*
+	A unit of work for the thread pool.
+*/
+class Task
+{
+public:
+	virtual ~Task();
+
+	/*
+		Do the work (called by a worker thread)
+	*/
+	virtual void run() = 0;
+};
+
+/*
+	A fixed set of POSIX threads executing tasks from a shared queue.
+	Tasks are not owned by the pool: they must live until wait() returns.
+*/
+class ThreadPool
+{
+public:
+	/*
+		Start n worker threads (n <= 0 means one per online processor)
+	*/
+	ThreadPool( int n );
+	~ThreadPool();
+
+	/*
+		Queue a task
+	*/
+	void push( Task * task );
+
+	/*
+		Block until all the queued tasks are done
+	*/
+	void wait();
+
+	/*
+		Return the number of worker threads
+	*/
+	int getNumThreads() const;
+
+	/*
+		Return the number of online processors
+	*/
+	static int getNumProcessors();
+
+private:
+	std::vector<pthread_t> _threads;
+	std::deque<Task *> _queue;
+	pthread_mutex_t _mutex;
+	pthread_cond_t _ready, // A task is queued or the pool stops
+	               _done;  // All the tasks are done
+	int _pending;          // Number of tasks queued or running
+	bool _stop;
+
+	// Not copyable
+	ThreadPool( const ThreadPool & );
+	ThreadPool & operator = ( const ThreadPool & );
+
+	static void * work( void * pool );
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline int ThreadPool::getNumThreads() const
+{
+	return _threads.size();
+}
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef TIMER_HPP
+#define TIMER_HPP
+
+/*
+	A wall-clock timer based on the POSIX monotonic clock.
+*/
+class Timer
+{
+public:
+	Timer();
+
+	/*
+		Restart the timer
+	*/
+	void start();
+
+	/*
+		Return the number of seconds elapsed since the timer was started
+	*/
+	double getElapsed() const;
+
+private:
+	double _start;
+
+	static double now();
+};
+
+#endif
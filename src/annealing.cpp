@@ -0,0 +1,147 @@
+#include "annealing.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cmath>
+#include <limits>
+
+SimulatedAnnealing::SimulatedAnnealing( const Problem & p ) :
+	_numJobs( p.getNumJobs() ),
+	_schedule( Geometric ),
+	_reheat( 50 ),
+	_maxEvaluations( 100000 ),
+	_numEvaluations( 0 ),
+	_numAborted( 0 ),
+	_numReheats( 0 ),
+	_archive( 0 ),
+	_budget( 0 ),
+	_seed( 1 ),
+	_t0( 5.0 ),
+	_rate( 0.95 ),
+	_elapsed( 0.0 )
+{
+}
+
+void SimulatedAnnealing::solve( Solution & s )
+{
+	Timer timer;
+	std::vector<int> best( s.getSequence() );
+	int bestCmax( s.getCmax() ), cmax( s.getCmax() ), stage( 0 ), lastImprovement( 0 );
+	double t( _t0 ), sum( 0.0 ), sum2( 0.0 );
+
+	_numEvaluations = 0;
+	_numAborted = 0;
+	_numReheats = 0;
+
+	// When no job can move, the list is the only topological order
+	bool movable( false );
+	for ( int i = 1; i < s.size()-1 && !movable; ++i )
+	{
+		int lo, hi;
+		s.getMoveWindow( i, lo, hi );
+		movable = ( lo < hi );
+	}
+
+	while ( movable && _numEvaluations < _maxEvaluations && !( _budget && _budget->isExhausted() ) )
+	{
+		int lo, hi, i, k;
+
+		// The source and the sink never move
+		i = 1 + rand_r( &_seed ) % ( s.size() - 2 );
+		s.getMoveWindow( i, lo, hi );
+		if ( lo == hi )
+			continue;
+
+		k = lo + rand_r( &_seed ) % ( hi - lo );
+		if ( k >= i )
+			++k;
+
+		// Metropolis: accept if Cmax - cmax <= -t log(u), so the largest
+		// acceptable makespan is known before the decoding
+		double u = ( rand_r( &_seed ) + 1.0 ) / ( RAND_MAX + 2.0 );
+		int cutoff = cmax + (int)std::min( -t * std::log( u ), (double)std::numeric_limits<int>::max() - cmax );
+
+		s.move( i, k );
+		++_numEvaluations;
+
+		if ( _budget )
+			_budget->count( 1 );
+
+		if ( s.update( std::min( i, k ), cutoff ) )
+		{
+			cmax = s.getCmax();
+			if ( cmax < bestCmax )
+			{
+				bestCmax = cmax;
+				lastImprovement = stage;
+				best = s.getSequence();
+				s.shrink( bestCmax );
+
+				if ( _archive )
+					_archive->publish( s );
+			}
+		}
+		else
+		{
+			++_numAborted;
+			s.undo( i, k );
+		}
+
+		sum += cmax;
+		sum2 += (double)cmax * cmax;
+
+		// One stage of the cooling schedule lasts n evaluations
+		if ( _numEvaluations % _numJobs == 0 )
+		{
+			t = cool( t, sum, sum2, _numJobs );
+			sum = sum2 = 0.0;
+			++stage;
+
+			// Restart from the best solution with the initial temperature,
+			// which may have been found by another solver
+			if ( _reheat > 0 && stage - lastImprovement >= _reheat )
+			{
+				const Archive::Entry * e = _archive ? _archive->getBest() : 0;
+				if ( e != 0 && e->cmax < bestCmax )
+				{
+					best = e->sequence;
+					bestCmax = e->cmax;
+				}
+
+				s.setSequence( best );
+				cmax = bestCmax;
+				t = _t0;
+				lastImprovement = stage;
+				++_numReheats;
+			}
+		}
+	}
+
+	s.setSequence( best );
+
+	_elapsed = timer.getElapsed();
+}
+
+double SimulatedAnnealing::cool( double t, double sum, double sum2, int n ) const
+{
+	if ( _schedule == Adaptive )
+	{
+		double mean = sum / n,
+		       sigma = std::sqrt( std::max( 0.0, sum2 / n - mean * mean ) );
+
+		// A flat stage gives no information, fall back to geometric cooling
+		if ( sigma > 0.0 )
+			return t * std::max( 0.5, std::exp( -0.7 * t / sigma ) );
+	}
+
+	return t * _rate;
+}
+
+void SimulatedAnnealing::exportSummary( std::ostream & os ) const
+{
+	os
+		<< "Evaluations: " << _numEvaluations
+		<< " (" << ( _elapsed > 0.0 ? _numEvaluations / _elapsed : 0.0 ) << "/s)" << std::endl
+		<< "Abandoned decodings: " << _numAborted << std::endl
+		<< "Reheats: " << _numReheats << std::endl
+		<< "Search time: " << _elapsed << " s" << std::endl;
+}
@@ -0,0 +1,143 @@
+#include "archive.hpp"
+#include <limits>
+
+Archive::Archive( int capacity ) :
+	_bestCmax( std::numeric_limits<int>::max() ),
+	_best( 0 ),
+	_retired( 0 ),
+	_slots( 0 ),
+	_capacity( capacity > 0 ? capacity : 1 ),
+	_size( 0 ),
+	_budget( 0 )
+{
+	_slots = new Entry * volatile[_capacity];
+	pthread_mutex_init( &_mutex, 0 );
+}
+
+Archive::~Archive()
+{
+	for ( Entry * e = _retired; e != 0; )
+	{
+		Entry * next = e->retired;
+		delete e;
+		e = next;
+	}
+
+	delete _best;
+
+	for ( int i = 0; i < _size; ++i )
+	{
+		delete _slots[i];
+	}
+	delete [] _slots;
+
+	pthread_mutex_destroy( &_mutex );
+}
+
+bool Archive::publish( const Solution & s )
+{
+	int cmax( s.getCmax() );
+	bool best( false );
+
+	// Most offers are worse than the whole (full) archive: reject them without lock
+	if ( cmax >= _bestCmax && _size == _capacity && cmax >= _slots[_size-1]->cmax )
+		return false;
+
+	if ( cmax < _bestCmax )
+	{
+		Entry * e = new Entry;
+		e->cmax = cmax;
+		e->sequence = s.getSequence();
+		e->retired = 0;
+		best = improve( e );
+	}
+
+	Entry * e = new Entry;
+	e->cmax = cmax;
+	e->sequence = s.getSequence();
+	e->retired = 0;
+
+	pthread_mutex_lock( &_mutex );
+	if ( !insert( e ) )
+		delete e;
+	pthread_mutex_unlock( &_mutex );
+
+	return best;
+}
+
+bool Archive::improve( Entry * e )
+{
+	for ( ;; )
+	{
+		Entry * old = _best;
+
+		if ( old != 0 && old->cmax <= e->cmax )
+		{
+			delete e;
+			return false;
+		}
+
+		if ( __sync_bool_compare_and_swap( &_best, old, e ) )
+		{
+			if ( old != 0 )
+				retire( old );
+
+			if ( _budget )
+				_budget->record( e->cmax );
+			break;
+		}
+	}
+
+	// Lower the best makespan (another thread may have lowered it more)
+	for ( int c = _bestCmax; e->cmax < c; c = _bestCmax )
+	{
+		if ( __sync_bool_compare_and_swap( &_bestCmax, c, e->cmax ) )
+			break;
+	}
+
+	return true;
+}
+
+bool Archive::insert( Entry * e )
+{
+	int n( _size ), i;
+
+	for ( i = 0; i < n; ++i )
+	{
+		if ( _slots[i]->cmax == e->cmax && _slots[i]->sequence == e->sequence )
+			return false;
+	}
+
+	// The slots are sorted by makespan, the last one is the worst
+	if ( n == _capacity )
+	{
+		if ( e->cmax >= _slots[n-1]->cmax )
+			return false;
+
+		retire( _slots[n-1] );
+		--n;
+	}
+
+	// Shift the worse entries: readers may see an entry twice, never a freed one
+	for ( i = n; i > 0 && _slots[i-1]->cmax > e->cmax; --i )
+	{
+		_slots[i] = _slots[i-1];
+	}
+
+	__sync_synchronize(); // The entry is complete before it is visible
+	_slots[i] = e;
+	__sync_synchronize();
+	_size = n+1;
+
+	return true;
+}
+
+void Archive::retire( Entry * e )
+{
+	// Lock-free push on the retired list
+	do
+	{
+		e->retired = _retired;
+	}
+	while ( !__sync_bool_compare_and_swap( &_retired, e->retired, e ) );
+}
@@ -3,25 +3,93 @@
 #include <cstdlib>
 
 int arguments::population_size( 100 );
+int arguments::local_search( 0 );
+int arguments::local_search_moves( 1000 );
+int arguments::engine( arguments::engine_grasp );
+int arguments::iterations( 1000 );
+int arguments::tabu_tenure( 7 );
+int arguments::tabu_sample( 50 );
+int arguments::sa_cooling( 0 );
+int arguments::sa_reheat( 50 );
+int arguments::sa_evaluations( 100000 );
+int arguments::path_relinking( 0 );
+int arguments::elite_size( 10 );
+int arguments::elite_distance( 4 );
+int arguments::threads( 0 );
+int arguments::refset_quality( 5 );
+int arguments::refset_diversity( 5 );
+int arguments::dedup( 0 );
+int arguments::diversity_window( 20 );
+int arguments::max_schedules( 0 );
+int arguments::target_makespan( 0 );
+int arguments::stagnation( 0 );
 int arguments::print_problem( 0 );
 int arguments::print_graph( 0 );
 int arguments::print_table( 0 );
 int arguments::print_plot( 0 );
 int arguments::verbose( 0 );
+int arguments::compile( 0 );
+int arguments::stats( 0 );
+int arguments::generate_jobs( 0 );
+int arguments::generate_resources( 4 );
+int arguments::generate_count( 1 );
 int arguments::help( 0 );
 unsigned int arguments::random_seed( 0 );
 double arguments::alpha( 0.75 );
+double arguments::sa_temperature( 5.0 );
+double arguments::sa_rate( 0.95 );
+double arguments::time_limit( 0.0 );
+double arguments::diversity_threshold( 0.5 );
+double arguments::network_complexity( 1.5 );
+double arguments::resource_factor( 0.5 );
+double arguments::resource_strength( 0.5 );
 
 std::string arguments::filename;
+std::string arguments::trace;
+std::string arguments::batch;
 
 const struct option arguments::long_options[] = {
 	{ "population-size", required_argument, 0,                         'p'                       },
 	{ "alpha",           required_argument, 0,                         'a'                       },
 	{ "random-seed",     required_argument, 0,                         arguments::id_random_seed },
+	{ "local-search",    required_argument, 0,                         arguments::id_local_search },
+	{ "ls-moves",        required_argument, 0,                         arguments::id_local_search_moves },
+	{ "engine",          required_argument, 0,                         arguments::id_engine },
+	{ "iterations",      required_argument, 0,                         arguments::id_iterations },
+	{ "tabu-tenure",     required_argument, 0,                         arguments::id_tabu_tenure },
+	{ "tabu-sample",     required_argument, 0,                         arguments::id_tabu_sample },
+	{ "sa-temperature",  required_argument, 0,                         arguments::id_sa_temperature },
+	{ "sa-cooling",      required_argument, 0,                         arguments::id_sa_cooling },
+	{ "sa-rate",         required_argument, 0,                         arguments::id_sa_rate },
+	{ "sa-reheat",       required_argument, 0,                         arguments::id_sa_reheat },
+	{ "sa-evaluations",  required_argument, 0,                         arguments::id_sa_evaluations },
+	{ "time-limit",      required_argument, 0,                         arguments::id_time_limit },
+	{ "path-relinking",  no_argument,       &arguments::path_relinking, 1 },
+	{ "elite-size",      required_argument, 0,                         arguments::id_elite_size },
+	{ "elite-distance",  required_argument, 0,                         arguments::id_elite_distance },
+	{ "threads",         required_argument, 0,                         arguments::id_threads },
+	{ "refset-quality",  required_argument, 0,                         arguments::id_refset_quality },
+	{ "refset-diversity", required_argument, 0,                        arguments::id_refset_diversity },
+	{ "dedup",           no_argument,       &arguments::dedup,         1 },
+	{ "diversity-window", required_argument, 0,                        arguments::id_diversity_window },
+	{ "diversity-threshold", required_argument, 0,                     arguments::id_diversity_threshold },
+	{ "max-schedules",   required_argument, 0,                         arguments::id_max_schedules },
+	{ "target-makespan", required_argument, 0,                         arguments::id_target_makespan },
+	{ "stagnation",      required_argument, 0,                         arguments::id_stagnation },
+	{ "trace",           required_argument, 0,                         arguments::id_trace },
+	{ "batch",           required_argument, 0,                         arguments::id_batch },
+	{ "compile",         no_argument,       &arguments::compile,       1                         },
+	{ "generate",        required_argument, 0,                         arguments::id_generate_jobs },
+	{ "resources",       required_argument, 0,                         arguments::id_generate_resources },
+	{ "count",           required_argument, 0,                         arguments::id_generate_count },
+	{ "network-complexity", required_argument, 0,                      arguments::id_network_complexity },
+	{ "resource-factor", required_argument, 0,                         arguments::id_resource_factor },
+	{ "resource-strength", required_argument, 0,                       arguments::id_resource_strength },
 	{ "print-problem",   no_argument,       &arguments::print_problem, 1                         },
 	{ "print-graph",     no_argument,       &arguments::print_graph,   1                         },
 	{ "print-table",     no_argument,       &arguments::print_table,   1                         },
 	{ "print-plot",      no_argument,       &arguments::print_plot,    1                         },
+	{ "stats",           no_argument,       &arguments::stats,         1                         },
 	{ "verbose",         no_argument,       &arguments::verbose,       1                         },
 	{ "brief",           no_argument,       &arguments::verbose,       0                         },
 	{ "help",            no_argument,       &arguments::help,          1                         },
@@ -53,6 +121,133 @@ void arguments::parse( int argc, char *argv[] )
 				std::istringstream( optarg ) >> random_seed;
 				break;
 
+			case id_local_search:
+				// Strategy name: first or best (improvement)
+				if ( std::string( optarg ) == "first" )
+					local_search = 1;
+				else if ( std::string( optarg ) == "best" )
+					local_search = 2;
+				else
+					local_search = 0;
+				break;
+
+			case id_local_search_moves:
+				std::istringstream( optarg ) >> local_search_moves;
+				break;
+
+			case id_engine:
+				engine = getEngine( optarg );
+				break;
+
+			case id_iterations:
+				std::istringstream( optarg ) >> iterations;
+				break;
+
+			case id_tabu_tenure:
+				std::istringstream( optarg ) >> tabu_tenure;
+				break;
+
+			case id_tabu_sample:
+				std::istringstream( optarg ) >> tabu_sample;
+				break;
+
+			case id_sa_temperature:
+				std::istringstream( optarg ) >> sa_temperature;
+				break;
+
+			case id_sa_cooling:
+				// Cooling schedule name: geometric or adaptive
+				sa_cooling = ( std::string( optarg ) == "adaptive" ) ? 1 : 0;
+				break;
+
+			case id_sa_rate:
+				std::istringstream( optarg ) >> sa_rate;
+				break;
+
+			case id_sa_reheat:
+				std::istringstream( optarg ) >> sa_reheat;
+				break;
+
+			case id_sa_evaluations:
+				std::istringstream( optarg ) >> sa_evaluations;
+				break;
+
+			case id_time_limit:
+				std::istringstream( optarg ) >> time_limit;
+				break;
+
+			case id_elite_size:
+				std::istringstream( optarg ) >> elite_size;
+				break;
+
+			case id_elite_distance:
+				std::istringstream( optarg ) >> elite_distance;
+				break;
+
+			case id_threads:
+				std::istringstream( optarg ) >> threads;
+				break;
+
+			case id_refset_quality:
+				std::istringstream( optarg ) >> refset_quality;
+				break;
+
+			case id_refset_diversity:
+				std::istringstream( optarg ) >> refset_diversity;
+				break;
+
+			case id_diversity_window:
+				std::istringstream( optarg ) >> diversity_window;
+				break;
+
+			case id_diversity_threshold:
+				std::istringstream( optarg ) >> diversity_threshold;
+				break;
+
+			case id_max_schedules:
+				std::istringstream( optarg ) >> max_schedules;
+				break;
+
+			case id_target_makespan:
+				std::istringstream( optarg ) >> target_makespan;
+				break;
+
+			case id_stagnation:
+				std::istringstream( optarg ) >> stagnation;
+				break;
+
+			case id_trace:
+				trace = optarg;
+				break;
+
+			case id_batch:
+				batch = optarg;
+				break;
+
+			case id_generate_jobs:
+				std::istringstream( optarg ) >> generate_jobs;
+				break;
+
+			case id_generate_resources:
+				std::istringstream( optarg ) >> generate_resources;
+				break;
+
+			case id_generate_count:
+				std::istringstream( optarg ) >> generate_count;
+				break;
+
+			case id_network_complexity:
+				std::istringstream( optarg ) >> network_complexity;
+				break;
+
+			case id_resource_factor:
+				std::istringstream( optarg ) >> resource_factor;
+				break;
+
+			case id_resource_strength:
+				std::istringstream( optarg ) >> resource_strength;
+				break;
+
 			case 0:
 			case -1:
 				break;
@@ -77,11 +272,62 @@ void arguments::print( std::ostream & os )
 		<< "\tpopulation-size = " << population_size << std::endl
 		<< "\talpha           = " << alpha           << std::endl
 		<< "\trandom_seed     = " << random_seed     << std::endl
+		<< "\tlocal-search    = " << local_search    << std::endl
+		<< "\tls-moves        = " << local_search_moves << std::endl
+		<< "\tengine          = " << engine          << std::endl
+		<< "\titerations      = " << iterations      << std::endl
+		<< "\ttabu-tenure     = " << tabu_tenure     << std::endl
+		<< "\ttabu-sample     = " << tabu_sample     << std::endl
+		<< "\tsa-temperature  = " << sa_temperature  << std::endl
+		<< "\tsa-cooling      = " << sa_cooling      << std::endl
+		<< "\tsa-rate         = " << sa_rate         << std::endl
+		<< "\tsa-reheat       = " << sa_reheat       << std::endl
+		<< "\tsa-evaluations  = " << sa_evaluations  << std::endl
+		<< "\ttime-limit      = " << time_limit      << std::endl
+		<< "\tpath-relinking  = " << path_relinking  << std::endl
+		<< "\telite-size      = " << elite_size      << std::endl
+		<< "\telite-distance  = " << elite_distance  << std::endl
+		<< "\tthreads         = " << threads         << std::endl
+		<< "\trefset-quality  = " << refset_quality  << std::endl
+		<< "\trefset-diversity = " << refset_diversity << std::endl
+		<< "\tdedup           = " << dedup           << std::endl
+		<< "\tdiversity-window = " << diversity_window << std::endl
+		<< "\tdiversity-threshold = " << diversity_threshold << std::endl
+		<< "\tmax-schedules   = " << max_schedules   << std::endl
+		<< "\ttarget-makespan = " << target_makespan << std::endl
+		<< "\tstagnation      = " << stagnation      << std::endl
+		<< "\ttrace           = " << trace           << std::endl
+		<< "\tbatch           = " << batch           << std::endl
+		<< "\tgenerate        = " << generate_jobs   << std::endl
+		<< "\tresources       = " << generate_resources << std::endl
+		<< "\tcount           = " << generate_count  << std::endl
+		<< "\tnetwork-complexity = " << network_complexity << std::endl
+		<< "\tresource-factor = " << resource_factor << std::endl
+		<< "\tresource-strength = " << resource_strength << std::endl
 		<< std::endl;
 }
 
+int arguments::getEngine( const std::string & name )
+{
+	for ( int e = engine_tabu; e <= engine_exact; ++e )
+	{
+		if ( name == getEngineName( e ) )
+			return e;
+	}
+	return engine_grasp;
+}
+
+const char * arguments::getEngineName( int engine )
+{
+	static const char * const names[] = { "grasp", "tabu", "annealing", "scatter", "exact" };
+	return engine >= engine_grasp && engine <= engine_exact ? names[engine] : "unknown";
+}
+
 void arguments::usage( const char * program_name, std::ostream & os )
 {
-	os << "Usage: " << program_name << " <instance-name> [-p size-of-population]" << std::endl;
+	os << "Usage: " << program_name << " <instance-name>|- [-p size-of-population]" << std::endl
+	   << "       " << program_name << " --batch <directory|list-file> [options]" << std::endl
+	   << "       " << program_name << " --compile <instance-name> | --batch <directory|list-file>" << std::endl
+	   << "       " << program_name << " --generate <jobs> [--count n] [output-name]" << std::endl;
 }
 
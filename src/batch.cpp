@@ -0,0 +1,166 @@
+#include "batch.hpp"
+#include "problem.hpp"
+#include "solver.hpp"
+#include "budget.hpp"
+#include "threadpool.hpp"
+#include "loader.hpp"
+#include "binary.hpp"
+#include "stats.hpp"
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <pthread.h>
+
+/*
+	A worker thread of the batch: solves the instances until none is left.
+*/
+class BatchTask : public Task
+{
+public:
+	BatchTask( const std::vector<std::string> & filenames, unsigned int seed, volatile int * next, pthread_mutex_t * mutex, std::ostream & os ) :
+		_filenames( filenames ),
+		_seed( seed ),
+		_next( next ),
+		_mutex( mutex ),
+		_os( os )
+	{
+		// The instances are already solved in parallel
+		_solver.setNumThreads( 1 );
+	}
+
+	void run()
+	{
+		int i;
+
+		while ( ( i = __sync_fetch_and_add( _next, 1 ) ) < (int)_filenames.size() )
+		{
+			try
+			{
+				if ( !loader::load( _filenames[i], _problem ) )
+					throw std::runtime_error( "cannot be read" );
+			}
+			catch ( const std::exception & e )
+			{
+				pthread_mutex_lock( _mutex );
+				std::clog << "Invalid instance " << _filenames[i] << ": " << e.what() << std::endl;
+				pthread_mutex_unlock( _mutex );
+				continue;
+			}
+
+			Budget budget;
+			_solver.setSeed( _seed + i );
+			_solver.solve( _problem, budget );
+
+			STATS_PHASE( Export );
+			pthread_mutex_lock( _mutex );
+			_os << _filenames[i] << ','
+			    << _solver.getLowerBound() << ','
+			    << _solver.getBestCmax() << ','
+			    << budget.getElapsed() << ','
+			    << budget.getNumSchedules() << std::endl;
+			pthread_mutex_unlock( _mutex );
+		}
+	}
+
+private:
+	const std::vector<std::string> & _filenames;
+	unsigned int _seed;
+	volatile int * _next;
+	pthread_mutex_t * _mutex;
+	std::ostream & _os;
+
+	Problem _problem;
+	Solver _solver;
+};
+
+Batch::Batch() :
+	_seed( 1 )
+{
+}
+
+bool Batch::load( const std::string & path )
+{
+	struct stat st;
+
+	if ( stat( path.c_str(), &st ) != 0 )
+		return false;
+
+	if ( S_ISDIR( st.st_mode ) )
+	{
+		DIR * dir = opendir( path.c_str() );
+		std::vector<std::string> filenames;
+		struct dirent * entry;
+
+		if ( dir == 0 )
+			return false;
+
+		// Regular files, in the order of their names (a cache is loaded with its source)
+		while ( ( entry = readdir( dir ) ) != 0 )
+		{
+			std::string filename( path + '/' + entry->d_name ),
+			            suffix( binary::extension );
+
+			if ( filename.size() > suffix.size() && filename.compare( filename.size() - suffix.size(), suffix.size(), suffix ) == 0 )
+				continue;
+
+			if ( entry->d_name[0] != '.' && stat( filename.c_str(), &st ) == 0 && S_ISREG( st.st_mode ) )
+				filenames.push_back( filename );
+		}
+		closedir( dir );
+
+		std::sort( filenames.begin(), filenames.end() );
+		_filenames.insert( _filenames.end(), filenames.begin(), filenames.end() );
+	}
+	else
+	{
+		std::ifstream list( path.c_str() );
+		std::string line;
+
+		if ( !list )
+			return false;
+
+		while ( std::getline( list, line ) )
+		{
+			std::string::size_type first( line.find_first_not_of( " \t\r" ) ),
+			                       last( line.find_last_not_of( " \t\r" ) );
+
+			if ( first != std::string::npos && line[first] != '#' )
+				_filenames.push_back( line.substr( first, last - first + 1 ) );
+		}
+	}
+
+	return true;
+}
+
+void Batch::run( int n, std::ostream & os ) const
+{
+	volatile int next( 0 );
+	pthread_mutex_t mutex;
+
+	if ( n <= 0 )
+		n = ThreadPool::getNumProcessors();
+	n = std::max( 1, std::min( n, size() ) );
+
+	os << "instance,lower_bound,makespan,time,schedules" << std::endl;
+
+	pthread_mutex_init( &mutex, 0 );
+	{
+		ThreadPool pool( n );
+		std::vector<BatchTask *> tasks;
+
+		for ( int t = 0; t < n; ++t )
+		{
+			tasks.push_back( new BatchTask( _filenames, _seed, &next, &mutex, os ) );
+			pool.push( tasks.back() );
+		}
+		pool.wait();
+
+		for ( int t = 0; t < n; ++t )
+		{
+			delete tasks[t];
+		}
+	}
+	pthread_mutex_destroy( &mutex );
+}
@@ -0,0 +1,326 @@
+#include "binary.hpp"
+#include "loader.hpp"
+#include "mappedfile.hpp"
+#include <fstream>
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <cstring>
+#include <cstdio>
+
+const char * const binary::extension = ".bin";
+
+/*
+	Layout of a compiled instance: the header, then arrays of ints
+		capacities       [numResources]
+		durations        [numJobs]
+		requests         [numJobs * numResources] (row j: requests of the job j)
+		successor starts [numJobs + 1]            (successors of j: [start[j], start[j+1]))
+		successors       [numArcs]
+		topological order, heads, tails [numJobs each]
+		latest starts    [numJobs]                (if hasLatestStart)
+	in the byte order of the machine which compiled it. The size of the
+	source is split in two 32 bits halves, it may exceed 4 GB.
+*/
+struct BinaryHeader
+{
+	char magic[8];
+	unsigned int version,
+	             byteOrder,
+	             sourceHash,
+	             sourceSizeLow,
+	             sourceSizeHigh;
+	int numJobs,
+	    numResources,
+	    numArcs,
+	    horizon,
+	    criticalPathBound,
+	    resourceBound,
+	    energeticBound,
+	    nodePackingBound,
+	    timetableBound,
+	    heuristicBound,
+	    hasLatestStart;
+};
+
+static const char binaryMagic[8] = { 'R', 'C', 'P', 'S', 'P', 'B', 'I', 'N' };
+static const unsigned int binaryVersion = 2,
+                          binaryByteOrder = 0x01020304;
+
+// Split a file size into the halves of the header
+static void setSourceSize( BinaryHeader & h, unsigned long size )
+{
+	h.sourceSizeLow = size & 0xffffffffUL;
+	h.sourceSizeHigh = ( size >> 16 ) >> 16; // Two shifts, long may have 32 bits
+}
+
+static bool hasSourceSize( const BinaryHeader & h, unsigned long size )
+{
+	BinaryHeader other;
+	setSourceSize( other, size );
+	return h.sourceSizeLow == other.sourceSizeLow && h.sourceSizeHigh == other.sourceSizeHigh;
+}
+
+bool binary::isBinary( const char * begin, const char * end )
+{
+	return end - begin >= (long)sizeof( binaryMagic ) && std::memcmp( begin, binaryMagic, sizeof( binaryMagic ) ) == 0;
+}
+
+bool binary::read( const char * begin, const char * end, Problem & p )
+{
+	BinaryHeader h;
+
+	if ( end - begin < (long)sizeof( h ) )
+		return false;
+
+	std::memcpy( &h, begin, sizeof( h ) );
+	if ( std::memcmp( h.magic, binaryMagic, sizeof( binaryMagic ) ) != 0
+	  || h.version != binaryVersion || h.byteOrder != binaryByteOrder )
+		return false;
+
+	// Check the sizes before computing the length of the arrays
+	if ( h.numJobs <= 0 || h.numJobs > ( 1 << 20 ) || h.numResources < 0 || h.numResources > ( 1 << 10 ) || h.numArcs < 0 )
+		return false;
+
+	const int n( h.numJobs ), m( h.numResources );
+	const long length( m + n + (long)n * m + n + 1 + h.numArcs + ( h.hasLatestStart ? 4 : 3 ) * (long)n );
+
+	if ( end - begin != (long)sizeof( h ) + length * (long)sizeof( int ) )
+		return false;
+
+	// The buffer is mapped (or allocated) on a page boundary, and the header size is a multiple of 4
+	const int * capacity = reinterpret_cast<const int *>( begin + sizeof( h ) ),
+	          * duration = capacity + m,
+	          * request = duration + n,
+	          * start = request + n * m,
+	          * successor = start + n + 1,
+	          * order = successor + h.numArcs,
+	          * head = order + n,
+	          * tail = head + n,
+	          * latestStart = tail + n;
+
+	// Check the precedences and the order before the first change of p
+	if ( start[0] != 0 || start[n] != h.numArcs )
+		return false;
+
+	std::vector<int> position( n, -1 );
+	for ( int i = 0; i < n; ++i )
+	{
+		if ( order[i] < 0 || order[i] >= n || position[order[i]] != -1 )
+			return false;
+		position[order[i]] = i;
+	}
+
+	for ( int j = 0; j < n; ++j )
+	{
+		if ( start[j] > start[j+1] )
+			return false;
+
+		// A successor comes later in the order (which also rules out cycles)
+		for ( int a = start[j]; a < start[j+1]; ++a )
+		{
+			if ( successor[a] < 0 || successor[a] >= n || position[successor[a]] <= position[j] )
+				return false;
+		}
+	}
+
+	// Range of the data: the solvers trust it as much as a parsed instance
+	for ( int k = 0; k < m; ++k )
+	{
+		if ( capacity[k] < 0 )
+			return false;
+	}
+
+	int total( 0 );
+	for ( int j = 0; j < n; ++j )
+	{
+		// The sum of the durations bounds every time of a schedule, it must fit an int
+		if ( duration[j] < 0 || duration[j] > std::numeric_limits<int>::max() - total )
+			return false;
+		total += duration[j];
+
+		for ( int k = 0; k < m; ++k )
+		{
+			if ( request[j * m + k] < 0 || request[j * m + k] > capacity[k] )
+				return false;
+		}
+	}
+
+	// Heads and tails are recomputed rather than trusted (two linear passes)
+	std::vector<int> jobHead( n, 0 ), jobTail( n, 0 );
+	for ( int i = 0; i < n; ++i )
+	{
+		int j = order[i];
+		for ( int a = start[j]; a < start[j+1]; ++a )
+			jobHead[successor[a]] = std::max( jobHead[successor[a]], jobHead[j] + duration[j] );
+	}
+	for ( int i = n-1; i >= 0; --i )
+	{
+		int j = order[i];
+		for ( int a = start[j]; a < start[j+1]; ++a )
+			jobTail[j] = std::max( jobTail[j], duration[successor[a]] + jobTail[successor[a]] );
+	}
+
+	int criticalPath( 0 );
+	for ( int j = 0; j < n; ++j )
+	{
+		if ( head[j] != jobHead[j] || tail[j] != jobTail[j] )
+			return false;
+		criticalPath = std::max( criticalPath, head[j] + duration[j] );
+	}
+
+	// The lower bounds are below the heuristic bound, itself below the serial schedule of the sum of the durations
+	const int upper( h.heuristicBound );
+	if ( h.horizon < 0 || h.criticalPathBound != criticalPath || upper < criticalPath || upper > total
+	  || h.resourceBound < 0 || h.resourceBound > upper
+	  || h.energeticBound < 0 || h.energeticBound > upper
+	  || h.nodePackingBound < 0 || h.nodePackingBound > upper
+	  || h.timetableBound < 0 || h.timetableBound > upper
+	  || ( h.hasLatestStart != 0 && h.hasLatestStart != 1 ) )
+		return false;
+
+	// Propagation only tightens the latest starts of the heuristic bound
+	for ( int j = 0; h.hasLatestStart && j < n; ++j )
+	{
+		if ( latestStart[j] < head[j] || latestStart[j] > upper - duration[j] - tail[j] )
+			return false;
+	}
+
+	p.setNumJobs( n );
+	p.setNumResources( m );
+	p.setHorizon( h.horizon );
+
+	for ( int k = 0; k < m; ++k )
+		p.setResourceCapacity( k, capacity[k] );
+
+	for ( int j = 0; j < n; ++j )
+	{
+		p.setJobDuration( j, duration[j] );
+		p._jobRequest[j].assign( request + j * m, request + ( j + 1 ) * m );
+
+		for ( int a = start[j]; a < start[j+1]; ++a )
+			p.addJobSuccessor( j, successor[a] );
+	}
+
+	// Preprocessed data
+	p._topologicalOrder.assign( order, order + n );
+	p._jobHead.assign( head, head + n );
+	p._jobTail.assign( tail, tail + n );
+	if ( h.hasLatestStart )
+		p._jobLatestStart.assign( latestStart, latestStart + n );
+	else
+		p._jobLatestStart.clear();
+
+	p._criticalPathBound = h.criticalPathBound;
+	p._resourceBound = h.resourceBound;
+	p._energeticBound = h.energeticBound;
+	p._nodePackingBound = h.nodePackingBound;
+	p._timetableBound = h.timetableBound;
+	p._heuristicBound = h.heuristicBound;
+
+	// The transitive closure is cheaper to compute than to store
+	p.computeClosure();
+	return true;
+}
+
+bool binary::save( const std::string & filename, const Problem & p, unsigned int sourceHash, long sourceSize )
+{
+	const int n( p.getNumJobs() ), m( p.getNumResources() );
+	std::vector<int> data;
+	BinaryHeader h;
+
+	std::memset( &h, 0, sizeof( h ) );
+	std::memcpy( h.magic, binaryMagic, sizeof( binaryMagic ) );
+	h.version = binaryVersion;
+	h.byteOrder = binaryByteOrder;
+	h.sourceHash = sourceHash;
+	setSourceSize( h, sourceSize );
+	h.numJobs = n;
+	h.numResources = m;
+	h.horizon = p.getHorizon();
+	h.criticalPathBound = p._criticalPathBound;
+	h.resourceBound = p._resourceBound;
+	h.energeticBound = p._energeticBound;
+	h.nodePackingBound = p._nodePackingBound;
+	h.timetableBound = p._timetableBound;
+	h.heuristicBound = p._heuristicBound;
+	h.hasLatestStart = !p._jobLatestStart.empty();
+
+	data.insert( data.end(), p._resourceCapacity.begin(), p._resourceCapacity.end() );
+	data.insert( data.end(), p._jobDuration.begin(), p._jobDuration.end() );
+	for ( int j = 0; j < n; ++j )
+		data.insert( data.end(), p._jobRequest[j].begin(), p._jobRequest[j].end() );
+
+	data.push_back( 0 );
+	for ( int j = 0; j < n; ++j )
+		data.push_back( data.back() + p._jobSuccessors[j].size() );
+	for ( int j = 0; j < n; ++j )
+		data.insert( data.end(), p._jobSuccessors[j].begin(), p._jobSuccessors[j].end() );
+	h.numArcs = data.size() - ( m + n + n * m + n + 1 );
+
+	data.insert( data.end(), p._topologicalOrder.begin(), p._topologicalOrder.end() );
+	data.insert( data.end(), p._jobHead.begin(), p._jobHead.end() );
+	data.insert( data.end(), p._jobTail.begin(), p._jobTail.end() );
+	data.insert( data.end(), p._jobLatestStart.begin(), p._jobLatestStart.end() );
+
+	// Write a temporary file first, a reader never sees a partial cache
+	std::string temporary( filename + ".tmp" );
+	{
+		std::ofstream os( temporary.c_str(), std::ios::binary );
+
+		os.write( reinterpret_cast<const char *>( &h ), sizeof( h ) );
+		os.write( reinterpret_cast<const char *>( &data[0] ), data.size() * sizeof( int ) );
+		if ( !os )
+		{
+			std::remove( temporary.c_str() );
+			return false;
+		}
+	}
+
+	return std::rename( temporary.c_str(), filename.c_str() ) == 0;
+}
+
+bool binary::loadCache( const std::string & source, const char * begin, const char * end, Problem & p )
+{
+	MappedFile file;
+	BinaryHeader h;
+
+	if ( !file.open( getCacheName( source ) ) || file.size() < sizeof( h ) )
+		return false;
+
+	// Stale if the source changed since the compilation
+	std::memcpy( &h, file.begin(), sizeof( h ) );
+	if ( !hasSourceSize( h, end - begin ) || h.sourceHash != hash( begin, end ) )
+		return false;
+
+	return read( file.begin(), file.end(), p );
+}
+
+bool binary::compile( const std::string & source )
+{
+	MappedFile file;
+	Problem p;
+
+	if ( !file.open( source ) )
+		return false;
+
+	loader::parse( file.begin(), file.end(), p );
+	return save( getCacheName( source ), p, hash( file.begin(), file.end() ), file.size() );
+}
+
+std::string binary::getCacheName( const std::string & source )
+{
+	return source + extension;
+}
+
+unsigned int binary::hash( const char * begin, const char * end )
+{
+	unsigned int h( 2166136261u );
+
+	for ( const char * c = begin; c < end; ++c )
+	{
+		h ^= (unsigned char)*c;
+		h *= 16777619u;
+	}
+	return h;
+}
@@ -0,0 +1,458 @@
+#include "branchbound.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+BranchAndBound::BranchAndBound( const Problem & p ) :
+	_problem( p ),
+	_numJobs( p.getNumJobs() ),
+	_numResources( p.getNumResources() ),
+	_numWords( ( p.getNumJobs() + 8 * sizeof( unsigned long ) - 1 ) / ( 8 * sizeof( unsigned long ) ) ),
+	_upperBound( 0 ),
+	_lowerBound( 0 ),
+	_numNodes( 0 ),
+	_numCutsets( 0 ),
+	_archive( 0 ),
+	_budget( 0 ),
+	_rank( p.getNumJobs() ),
+	_start( p.getNumJobs() ),
+	_numPreds( p.getNumJobs() ),
+	_usage(),
+	_head( p.getNumJobs() ),
+	_cutset( _numWords ),
+	_zobrist( p.getNumJobs() ),
+	_hash( 0 ),
+	_job( p.getNumJobs() ),
+	_bound( p.getNumJobs() ),
+	_numEligible( p.getNumJobs() ),
+	_next( p.getNumJobs() ),
+	_first( p.getNumJobs() ),
+	_eligible(),
+	_eligibleStart(),
+	_mark( p.getNumJobs() ),
+	_propagator( p ),
+	_memoMask( -1 )
+{
+	const std::vector<int> & order( p.getTopologicalOrder() );
+	unsigned int seed( 1 );
+
+	for ( int i = 0; i < (int)order.size(); ++i )
+		_rank[order[i]] = i;
+
+	for ( int j = 0; j < _numJobs; ++j )
+	{
+		for ( int i = 0; i < 4; ++i )
+			_zobrist[j] = ( _zobrist[j] << 16 ) ^ rand_r( &seed );
+	}
+
+	// Keep the finish times memorized under 8 MB
+	setMemoSize( std::min( 1 << 16, ( 1 << 20 ) / std::max( 1, _numJobs ) ) );
+}
+
+void BranchAndBound::setMemoSize( int n )
+{
+	int size( 0 );
+	if ( n > 0 )
+	{
+		for ( size = 1; 2 * size <= n; size *= 2 );
+	}
+
+	_memoMask = size - 1;
+	_memoKey.assign( size * _numWords, 0 );
+	_memoTime.assign( size, 0 );
+	_memoRank.assign( size, 0 );
+	_memoCount.assign( size, -1 );
+	_memoFinish.assign( size * 2 * _numJobs, 0 );
+}
+
+bool BranchAndBound::solve( Solution & s )
+{
+	std::vector<int> best( s.getSequence() );
+	bool complete( true );
+	long counted( 0 );
+	int l( 0 ), step( 0 );
+
+	_numNodes = 0;
+	_numCutsets = 0;
+	_upperBound = s.getCmax();
+	_lowerBound = std::min( _problem.getLowerBound(), _upperBound );
+
+	// Empty partial schedule, no job can end after the upper bound
+	std::fill( _start.begin(), _start.end(), -1 );
+	for ( int j = 0; j < _numJobs; ++j )
+		_numPreds[j] = _problem.getJobPredecessors( j ).size();
+	_usage.assign( _upperBound * _numResources, 0 );
+	std::fill( _cutset.begin(), _cutset.end(), 0 );
+	std::fill( _memoCount.begin(), _memoCount.end(), -1 );
+	_hash = 0;
+
+	// The windows are propagated for a better makespan
+	if ( !_propagator.initialize( _upperBound - 1 ) )
+		_lowerBound = _upperBound;
+
+	expand( 0 );
+	while ( l >= 0 && _upperBound > _lowerBound )
+	{
+		// Check the stopping criteria from time to time
+		if ( ++step == 1024 && _budget )
+		{
+			step = 0;
+			_budget->count( _numNodes - counted );
+			counted = _numNodes;
+			if ( _budget->isExhausted() )
+			{
+				complete = false;
+				break;
+			}
+		}
+
+		// All the children of the node are explored: backtrack
+		if ( _next[l] == _numEligible[l] )
+		{
+			if ( --l >= 0 )
+				unschedule( l );
+			continue;
+		}
+
+		int j( _eligible[_first[l] + _next[l]] ),
+		    t( _eligibleStart[_first[l] + _next[l]] );
+		++_next[l];
+
+		// The job cannot end before the upper bound (which may have decreased)
+		if ( t + _problem.getJobDuration( j ) + _problem.getJobTail( j ) >= _upperBound )
+			continue;
+
+		++_numNodes;
+		if ( !schedule( l, j, t ) )
+		{
+			unschedule( l );
+			continue;
+		}
+
+		// A complete schedule (better than the upper bound, see findStart)
+		if ( l == _numJobs - 1 )
+		{
+			int cmax( 0 );
+			for ( int i = 0; i < _numJobs; ++i )
+				cmax = std::max( cmax, _start[i] + _problem.getJobDuration( i ) );
+
+			_upperBound = cmax;
+			best.assign( _job.begin(), _job.end() );
+
+			if ( _archive )
+			{
+				s.setSequence( best );
+				_archive->publish( s );
+			}
+
+			unschedule( l );
+			restart( l );
+			continue;
+		}
+
+		_bound[l] = computeBound( t );
+		if ( _bound[l] >= _upperBound )
+		{
+			unschedule( l );
+			continue;
+		}
+
+		if ( isDominated( j, t ) )
+		{
+			++_numCutsets;
+			unschedule( l );
+			continue;
+		}
+
+		expand( ++l );
+	}
+
+	if ( _budget )
+		_budget->count( _numNodes - counted );
+
+	// The nodes not explored are in the subtrees of the nodes of the stack
+	if ( complete )
+	{
+		_lowerBound = _upperBound;
+	}
+	else
+	{
+		int bound( _upperBound );
+		for ( int i = 0; i <= l; ++i )
+		{
+			if ( _next[i] < _numEligible[i] )
+				bound = std::min( bound, i > 0 ? _bound[i-1] : _lowerBound );
+		}
+		_lowerBound = std::max( _lowerBound, bound );
+	}
+
+	s.setSequence( best );
+	return complete || _upperBound <= _lowerBound;
+}
+
+void BranchAndBound::exportSummary( std::ostream & os ) const
+{
+	os << "Nodes: " << _numNodes << " (" << _numCutsets << " dominated cutsets)" << std::endl;
+	os << "Proven lower bound: " << _lowerBound << std::endl;
+}
+
+int BranchAndBound::findStart( int j ) const
+{
+	const std::vector<int> & predecessors( _problem.getJobPredecessors( j ) );
+	int t( 0 ),
+	    duration( _problem.getJobDuration( j ) ),
+	    latest( _propagator.getLatestStart( j ) );
+
+	for ( int i = 0; i < (int)predecessors.size(); ++i )
+		t = std::max( t, _start[predecessors[i]] + _problem.getJobDuration( predecessors[i] ) );
+
+	// Move t after each period without enough capacity
+	for ( int i = t; t <= latest && i < t + duration; ++i )
+	{
+		for ( int k = 0; k < _numResources; ++k )
+		{
+			if ( _usage[i * _numResources + k] + _problem.getJobRequest( j, k ) > _problem.getResourceCapacity( k ) )
+			{
+				t = i + 1;
+				break;
+			}
+		}
+	}
+
+	return t <= latest ? t : -1;
+}
+
+bool BranchAndBound::schedule( int l, int j, int t )
+{
+	const std::vector<int> & successors( _problem.getJobSuccessors( j ) );
+	const int bits = 8 * sizeof( unsigned long );
+
+	_job[l] = j;
+	_start[j] = t;
+	for ( int i = t; i < t + _problem.getJobDuration( j ); ++i )
+	{
+		for ( int k = 0; k < _numResources; ++k )
+			_usage[i * _numResources + k] += _problem.getJobRequest( j, k );
+	}
+
+	for ( int i = 0; i < (int)successors.size(); ++i )
+		--_numPreds[successors[i]];
+
+	_cutset[j / bits] |= 1UL << ( j % bits );
+	_hash ^= _zobrist[j];
+
+	_mark[l] = _propagator.getMark();
+	return _propagator.setStartTime( j, t );
+}
+
+void BranchAndBound::unschedule( int l )
+{
+	int j( _job[l] ), t( _start[j] );
+	const std::vector<int> & successors( _problem.getJobSuccessors( j ) );
+	const int bits = 8 * sizeof( unsigned long );
+
+	_propagator.undo( _mark[l] );
+
+	for ( int i = t; i < t + _problem.getJobDuration( j ); ++i )
+	{
+		for ( int k = 0; k < _numResources; ++k )
+			_usage[i * _numResources + k] -= _problem.getJobRequest( j, k );
+	}
+
+	for ( int i = 0; i < (int)successors.size(); ++i )
+		++_numPreds[successors[i]];
+
+	_start[j] = -1;
+	_cutset[j / bits] &= ~( 1UL << ( j % bits ) );
+	_hash ^= _zobrist[j];
+}
+
+void BranchAndBound::restart( int l )
+{
+	// No better schedule exists
+	if ( !_propagator.initialize( _upperBound - 1 ) )
+	{
+		_lowerBound = _upperBound;
+		return;
+	}
+
+	for ( int i = 0; i < l; ++i )
+	{
+		_mark[i] = _propagator.getMark();
+		if ( !_propagator.setStartTime( _job[i], _start[_job[i]] ) )
+		{
+			// The node of the level i cannot lead to a better schedule anymore
+			for ( int m = i + 1; m <= l; ++m )
+			{
+				_mark[m] = _propagator.getMark();
+				_next[m] = _numEligible[m];
+			}
+			return;
+		}
+	}
+}
+
+void BranchAndBound::expand( int l )
+{
+	// The sets of the levels are stacked: at most n-l jobs are eligible at the
+	// level l, the stack only grows with the eligible sets actually met
+	_first[l] = l > 0 ? _first[l-1] + _numEligible[l-1] : 0;
+	if ( (int)_eligible.size() < _first[l] + _numJobs - l )
+	{
+		_eligible.resize( _first[l] + _numJobs - l );
+		_eligibleStart.resize( _first[l] + _numJobs - l );
+	}
+
+	int * eligible( &_eligible[_first[l]] ),
+	    * start( &_eligibleStart[_first[l]] ),
+	    last( l > 0 ? _job[l-1] : -1 );
+
+	_numEligible[l] = 0;
+	_next[l] = 0;
+	for ( int j = 0; j < _numJobs; ++j )
+	{
+		if ( _start[j] >= 0 || _numPreds[j] > 0 )
+			continue;
+
+		int t( findStart( j ) ), i( _numEligible[l]++ );
+
+		// Left-shift rule: the schedule is reached in start time order.
+		// The job must also start in its window (findStart checks the latest start)
+		if ( t < 0 || t < _propagator.getEarliestStart( j )
+		  || ( last >= 0 && ( t < _start[last] || ( t == _start[last] && _rank[j] < _rank[last] ) ) ) )
+		{
+			--_numEligible[l];
+			continue;
+		}
+
+		// Eligible jobs by start time, then in topological order (so that the
+		// first children never break the left-shift rule)
+		for ( ; i > 0 && ( start[i-1] > t || ( start[i-1] == t && _rank[eligible[i-1]] > _rank[j] ) ); --i )
+		{
+			eligible[i] = eligible[i-1];
+			start[i] = start[i-1];
+		}
+		eligible[i] = j;
+		start[i] = t;
+	}
+}
+
+int BranchAndBound::computeBound( int t )
+{
+	const std::vector<int> & order( _problem.getTopologicalOrder() );
+	int bound( 0 );
+
+	// Critical path: no job starts before t
+	for ( int i = 0; i < _numJobs; ++i )
+	{
+		int j( order[i] ), head( t );
+
+		if ( _start[j] >= 0 )
+		{
+			bound = std::max( bound, _start[j] + _problem.getJobDuration( j ) + _problem.getJobTail( j ) );
+			continue;
+		}
+
+		const std::vector<int> & predecessors( _problem.getJobPredecessors( j ) );
+		head = std::max( head, _propagator.getEarliestStart( j ) );
+		for ( int p = 0; p < (int)predecessors.size(); ++p )
+		{
+			int q( predecessors[p] );
+			head = std::max( head, ( _start[q] >= 0 ? _start[q] : _head[q] ) + _problem.getJobDuration( q ) );
+		}
+
+		_head[j] = head;
+		bound = std::max( bound, head + _problem.getJobDuration( j ) + _problem.getJobTail( j ) );
+	}
+
+	// Energy: the work left after t on each resource
+	for ( int k = 0; k < _numResources; ++k )
+	{
+		int capacity( _problem.getResourceCapacity( k ) );
+		long energy( 0 );
+
+		if ( capacity == 0 )
+			continue;
+
+		for ( int j = 0; j < _numJobs; ++j )
+		{
+			int duration( _problem.getJobDuration( j ) );
+			if ( _start[j] < 0 )
+				energy += (long)duration * _problem.getJobRequest( j, k );
+			else if ( _start[j] + duration > t )
+				energy += (long)( _start[j] + duration - t ) * _problem.getJobRequest( j, k );
+		}
+
+		bound = std::max( bound, t + (int)( ( energy + capacity - 1 ) / capacity ) );
+	}
+
+	return bound;
+}
+
+bool BranchAndBound::isDominated( int j, int t )
+{
+	int slot( -1 );
+
+	if ( _memoMask < 0 )
+		return false;
+
+	// A few probes from the hash of the cutset
+	for ( int probe = 0; probe < 4; ++probe )
+	{
+		int e( ( _hash + probe ) & _memoMask );
+
+		if ( _memoCount[e] < 0 )
+		{
+			slot = e;
+			break;
+		}
+
+		if ( !std::equal( _cutset.begin(), _cutset.end(), _memoKey.begin() + e * _numWords ) )
+			continue;
+
+		// Same cutset: the completions of this node are completions of the memorized one
+		// if it could start them earlier, with its jobs in progress finishing earlier
+		if ( _memoTime[e] < t || ( _memoTime[e] == t && _memoRank[e] <= _rank[j] ) )
+		{
+			const int * finish( &_memoFinish[e * 2 * _numJobs] );
+			bool dominated( true );
+
+			for ( int i = 0; i < _memoCount[e] && dominated; ++i )
+			{
+				int q( finish[2*i] ), f( finish[2*i+1] );
+				dominated = ( f <= t || f <= _start[q] + _problem.getJobDuration( q ) );
+			}
+
+			if ( dominated )
+				return true;
+		}
+
+		// Keep the node with the earliest decision time
+		if ( _memoTime[e] < t )
+			return false;
+
+		slot = e;
+		break;
+	}
+
+	// Replace the first probe if the table is crowded
+	if ( slot < 0 )
+		slot = _hash & _memoMask;
+
+	std::copy( _cutset.begin(), _cutset.end(), _memoKey.begin() + slot * _numWords );
+	_memoTime[slot] = t;
+	_memoRank[slot] = _rank[j];
+	_memoCount[slot] = 0;
+
+	int * finish( &_memoFinish[slot * 2 * _numJobs] );
+	for ( int q = 0; q < _numJobs; ++q )
+	{
+		if ( _start[q] >= 0 && _start[q] + _problem.getJobDuration( q ) > t )
+		{
+			finish[2 * _memoCount[slot]] = q;
+			finish[2 * _memoCount[slot] + 1] = _start[q] + _problem.getJobDuration( q );
+			++_memoCount[slot];
+		}
+	}
+
+	return false;
+}
@@ -0,0 +1,68 @@
+#include "budget.hpp"
+#include <limits>
+
+Budget::Budget() :
+	_timer(),
+	_timeLimit( 0.0 ),
+	_maxSchedules( 0 ),
+	_stagnation( 0 ),
+	_target( 0 ),
+	_numSchedules( 0 ),
+	_lastImprovement( 0 ),
+	_bestCmax( std::numeric_limits<int>::max() ),
+	_stopped( false )
+{
+	pthread_mutex_init( &_mutex, 0 );
+}
+
+Budget::~Budget()
+{
+	pthread_mutex_destroy( &_mutex );
+}
+
+void Budget::record( int cmax )
+{
+	pthread_mutex_lock( &_mutex );
+
+	// Threads may report their improvements out of order
+	if ( cmax < _bestCmax )
+	{
+		_bestCmax = cmax;
+		long n( _numSchedules );
+
+		_lastImprovement = n;
+		_traceTime.push_back( getElapsed() );
+		_traceSchedules.push_back( n );
+		_traceCmax.push_back( cmax );
+	}
+
+	pthread_mutex_unlock( &_mutex );
+}
+
+bool Budget::isExhausted() const
+{
+	if ( !_stopped )
+	{
+		long n( _numSchedules );
+
+		_stopped =
+		    ( _maxSchedules > 0 && n >= _maxSchedules )
+		 || ( _target > 0 && _bestCmax <= _target )
+		 || ( _stagnation > 0 && n - _lastImprovement >= _stagnation )
+		 || ( _timeLimit > 0.0 && getElapsed() >= _timeLimit );
+	}
+	return _stopped;
+}
+
+void Budget::exportTrace( std::ostream & os ) const
+{
+	pthread_mutex_lock( &_mutex );
+
+	os << "time,schedules,makespan" << std::endl;
+	for ( int i = 0; i < (int)_traceCmax.size(); ++i )
+	{
+		os << _traceTime[i] << ',' << _traceSchedules[i] << ',' << _traceCmax[i] << std::endl;
+	}
+
+	pthread_mutex_unlock( &_mutex );
+}
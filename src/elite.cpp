@@ -0,0 +1,65 @@
+#include "elite.hpp"
+
+ElitePool::ElitePool( int capacity, int minDistance ) :
+	_capacity( capacity ),
+	_minDistance( minDistance )
+{
+}
+
+bool ElitePool::insert( const Solution & s )
+{
+	int cmax( s.getCmax() ), closest( -1 ), closestDistance( s.size() + 1 );
+	bool best( size() == 0 || cmax < getCmax( getBest() ) );
+
+	for ( int i = 0; i < size(); ++i )
+	{
+		int d = distance( s.getSequence(), _sequences[i] );
+
+		// Too close to an elite list, and no new best makespan
+		if ( d < _minDistance && !best )
+			return false;
+
+		// Among the lists the solution improves, find the most similar one
+		if ( cmax < _cmax[i] && d < closestDistance )
+		{
+			closest = i;
+			closestDistance = d;
+		}
+	}
+
+	if ( size() < _capacity )
+	{
+		_sequences.push_back( s.getSequence() );
+		_cmax.push_back( cmax );
+		return true;
+	}
+
+	if ( closest < 0 )
+		return false;
+
+	_sequences[closest] = s.getSequence();
+	_cmax[closest] = cmax;
+	return true;
+}
+
+int ElitePool::getBest() const
+{
+	int best( 0 );
+	for ( int i = 1; i < size(); ++i )
+	{
+		if ( _cmax[i] < _cmax[best] )
+			best = i;
+	}
+	return best;
+}
+
+int ElitePool::distance( const std::vector<int> & a, const std::vector<int> & b )
+{
+	int d( 0 );
+	for ( int i = 0; i < (int)a.size(); ++i )
+	{
+		if ( a[i] != b[i] )
+			++d;
+	}
+	return d;
+}
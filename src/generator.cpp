@@ -0,0 +1,220 @@
+#include "generator.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cmath>
+
+// Limit of the successors and of the predecessors of a non-dummy job
+static const int generatorMaxDegree = 3;
+
+Generator::Generator( unsigned int seed ) :
+	_seed( seed ),
+	_numJobs( 30 ),
+	_numResources( 4 ),
+	_networkComplexity( 1.5 ),
+	_resourceFactor( 0.5 ),
+	_resourceStrength( 0.5 ),
+	_mark( 0 )
+{
+}
+
+void Generator::generate( Problem & p )
+{
+	const int n( _numJobs ), m( _numResources ), sink( n + 1 );
+	std::vector<int> duration( n + 2, 0 ), head( n + 2, 0 ), resources( m );
+	std::vector< std::vector<int> > request( n + 2, std::vector<int>( m, 0 ) );
+	int horizon( 0 );
+
+	generateNetwork();
+
+	p.setNumJobs( n + 2 );
+	p.setNumResources( m );
+
+	for ( int j = 1; j <= n; ++j )
+	{
+		duration[j] = random( 1, 10 );
+		horizon += duration[j];
+	}
+
+	// Each job requests a random subset of the resources
+	int numRequested( m == 0 ? 0 : (int)( _resourceFactor * m + 0.5 ) );
+	numRequested = std::min( m, std::max( numRequested, _resourceFactor > 0.0 && m > 0 ? 1 : 0 ) );
+
+	for ( int k = 0; k < m; ++k )
+		resources[k] = k;
+
+	for ( int j = 1; j <= n; ++j )
+	{
+		for ( int i = 0; i < numRequested; ++i )
+		{
+			std::swap( resources[i], resources[random( i, m-1 )] );
+			request[j][resources[i]] = random( 1, 10 );
+		}
+	}
+
+	// Arcs in the order of the jobs, with the dummy source and sink
+	for ( int j = 0; j <= sink; ++j )
+	{
+		std::sort( _successors[j].begin(), _successors[j].end() );
+		p.setJobDuration( j, duration[j] );
+		for ( int k = 0; k < m; ++k )
+			p.setJobRequest( j, k, request[j][k] );
+
+		for ( int i = 0; i < (int)_successors[j].size(); ++i )
+		{
+			int s( _successors[j][i] );
+			p.addJobSuccessor( j, s );
+			head[s] = std::max( head[s], head[j] + duration[j] );
+		}
+	}
+
+	// Capacities between the largest request and the peak of the earliest start schedule
+	for ( int k = 0; k < m; ++k )
+	{
+		std::vector<int> usage( horizon + 1, 0 );
+		int kmin( 1 ), kmax( 0 ), level( 0 );
+
+		for ( int j = 1; j <= n; ++j )
+		{
+			kmin = std::max( kmin, request[j][k] );
+			usage[head[j]] += request[j][k];
+			usage[head[j] + duration[j]] -= request[j][k];
+		}
+
+		for ( int t = 0; t <= horizon; ++t )
+		{
+			level += usage[t];
+			kmax = std::max( kmax, level );
+		}
+		kmax = std::max( kmin, kmax );
+
+		p.setResourceCapacity( k, kmin + (int)( _resourceStrength * ( kmax - kmin ) + 0.5 ) );
+	}
+
+	p.setHorizon( horizon );
+	p.preprocess();
+}
+
+int Generator::random( int lo, int hi )
+{
+	return lo + rand_r( &_seed ) % ( hi - lo + 1 );
+}
+
+bool Generator::isReachable( int i, int j )
+{
+	// The arcs go forward: only the jobs between i and j can be on a path
+	++_mark;
+	_stack.clear();
+	_stack.push_back( i );
+
+	while ( !_stack.empty() )
+	{
+		int a( _stack.back() );
+		_stack.pop_back();
+
+		for ( int k = 0; k < (int)_successors[a].size(); ++k )
+		{
+			int s( _successors[a][k] );
+
+			if ( s == j )
+				return true;
+
+			if ( s < j && _visited[s] != _mark )
+			{
+				_visited[s] = _mark;
+				_stack.push_back( s );
+			}
+		}
+	}
+	return false;
+}
+
+bool Generator::addArc( int i, int j )
+{
+	if ( (int)_successors[i].size() >= generatorMaxDegree || (int)_predecessors[j].size() >= generatorMaxDegree )
+		return false;
+
+	// Redundant, or making i -> b or a -> j redundant
+	if ( isReachable( i, j ) )
+		return false;
+
+	for ( int k = 0; k < (int)_successors[i].size(); ++k )
+	{
+		if ( isReachable( j, _successors[i][k] ) )
+			return false;
+	}
+
+	for ( int k = 0; k < (int)_predecessors[j].size(); ++k )
+	{
+		if ( isReachable( _predecessors[j][k], i ) )
+			return false;
+	}
+
+	_successors[i].push_back( j );
+	_predecessors[j].push_back( i );
+	return true;
+}
+
+void Generator::generateNetwork()
+{
+	const int n( _numJobs ), sink( n + 1 ), numStart( std::min( n, generatorMaxDegree ) );
+
+	// The predecessors are drawn among the previous jobs of a window of
+	// about sqrt(n) jobs, which gives about sqrt(n) levels as in PSPLIB
+	const int window( std::max( numStart, (int)( 1.5 * std::sqrt( (double)n ) ) ) );
+
+	int numArcs( 0 ), numSources( 0 ), numSinks( 0 );
+
+	_successors.assign( n + 2, std::vector<int>() );
+	_predecessors.assign( n + 2, std::vector<int>() );
+	_visited.assign( n + 2, 0 );
+	_mark = 0;
+
+	// A predecessor for each job after the start jobs (the jobs of the window
+	// all have their successors, the job starts then from the source)
+	for ( int j = numStart + 1; j <= n; ++j )
+	{
+		for ( int attempt = 0; attempt < 2 * window && _predecessors[j].empty(); ++attempt )
+		{
+			if ( addArc( random( std::max( 1, j - window ), j - 1 ), j ) )
+				++numArcs;
+		}
+	}
+
+	for ( int j = 1; j <= n; ++j )
+	{
+		numSources += _predecessors[j].empty();
+		numSinks += _successors[j].empty();
+	}
+
+	// More arcs until the network complexity is reached (the arcs from the
+	// source and to the sink count, and an arc may remove one of each)
+	const int target( (int)( _networkComplexity * ( n + 2 ) + 0.5 ) );
+
+	for ( int attempt = 0; attempt < 20 * target && numArcs + numSources + numSinks < target && n > 1; ++attempt )
+	{
+		int i( random( 1, n - 1 ) ), j( random( i + 1, std::min( n, i + window ) ) );
+		bool source( _predecessors[j].empty() ), sinkArc( _successors[i].empty() );
+
+		if ( addArc( i, j ) )
+		{
+			++numArcs;
+			numSources -= source;
+			numSinks -= sinkArc;
+		}
+	}
+
+	// Dummy arcs
+	for ( int j = 1; j <= n; ++j )
+	{
+		if ( _predecessors[j].empty() )
+		{
+			_successors[0].push_back( j );
+			_predecessors[j].push_back( 0 );
+		}
+		if ( _successors[j].empty() )
+		{
+			_successors[j].push_back( sink );
+			_predecessors[sink].push_back( j );
+		}
+	}
+}
@@ -0,0 +1,89 @@
+#include "hashset.hpp"
+#include <algorithm>
+
+HashSet::HashSet( int window, double threshold ) :
+	_table( 64, 0 ),
+	_history( std::max( window, 1 ), true ),
+	_size( 0 ),
+	_numDuplicates( 0 ),
+	_numCandidates( 0 ),
+	_numDistinct( std::max( window, 1 ) ),
+	_threshold( threshold )
+{
+}
+
+bool HashSet::insert( const Solution & s )
+{
+	return insert( s.getScheduleHash() );
+}
+
+bool HashSet::insert( unsigned long h )
+{
+	std::size_t mask( _table.size() - 1 ), i;
+	bool distinct( true );
+
+	if ( h == 0 )
+		h = 1;
+
+	for ( i = h & mask; _table[i] != 0; i = ( i+1 ) & mask )
+	{
+		if ( _table[i] == h )
+		{
+			distinct = false;
+			break;
+		}
+	}
+
+	// Slide the window of the last candidates
+	int slot( _numCandidates % _history.size() );
+	_numDistinct += (int)distinct - (int)_history[slot];
+	_history[slot] = distinct;
+	++_numCandidates;
+
+	if ( !distinct )
+	{
+		++_numDuplicates;
+		return false;
+	}
+
+	_table[i] = h;
+	++_size;
+
+	// Keep the load factor under 1/2
+	if ( 2 * _size > (int)_table.size() )
+		grow();
+
+	return true;
+}
+
+void HashSet::clear()
+{
+	std::fill( _table.begin(), _table.end(), 0 );
+	std::fill( _history.begin(), _history.end(), true );
+	_size = 0;
+	_numCandidates = 0;
+	_numDistinct = _history.size();
+}
+
+double HashSet::getDiversity() const
+{
+	return (double)_numDistinct / _history.size();
+}
+
+void HashSet::grow()
+{
+	std::vector<unsigned long> table( 2 * _table.size(), 0 );
+	std::size_t mask( table.size() - 1 );
+
+	for ( std::size_t j = 0; j < _table.size(); ++j )
+	{
+		if ( _table[j] == 0 )
+			continue;
+
+		std::size_t i( _table[j] & mask );
+		while ( table[i] != 0 ) i = ( i+1 ) & mask;
+		table[i] = _table[j];
+	}
+
+	_table.swap( table );
+}
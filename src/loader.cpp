@@ -0,0 +1,47 @@
+#include "loader.hpp"
+#include "psplib.hpp"
+#include "patterson.hpp"
+#include "binary.hpp"
+#include "mappedfile.hpp"
+#include "stats.hpp"
+#include <stdexcept>
+
+bool loader::load( const std::string & filename, Problem & p )
+{
+	STATS_PHASE( Parse );
+	MappedFile file;
+
+	if ( !file.open( filename ) )
+		return false;
+
+	// A compiled instance, or a source with a fresh cache
+	if ( binary::isBinary( file.begin(), file.end() ) )
+	{
+		if ( !binary::read( file.begin(), file.end(), p ) )
+			throw std::runtime_error( "Invalid compiled instance" );
+		STATS_COUNT( CacheHits, 1 );
+	}
+	else if ( binary::loadCache( filename, file.begin(), file.end(), p ) )
+	{
+		STATS_COUNT( CacheHits, 1 );
+	}
+	else
+	{
+		parse( file.begin(), file.end(), p );
+	}
+	return true;
+}
+
+const char * loader::parse( const char * begin, const char * end, Problem & p )
+{
+	const char * c( begin );
+
+	// The first word tells the format
+	while ( c < end && ( *c == ' ' || *c == '\t' || *c == '\r' || *c == '\n' ) )
+		++c;
+
+	if ( c < end && *c >= '0' && *c <= '9' )
+		return patterson::parse( begin, end, p );
+
+	return psplib::parse( begin, end, p );
+}
@@ -1,26 +1,99 @@
 #include "problem.hpp"
 #include "solution.hpp"
+#include "solver.hpp"
+#include "batch.hpp"
+#include "pipeline.hpp"
+#include "budget.hpp"
 #include "arguments.hpp"
+#include "loader.hpp"
+#include "binary.hpp"
+#include "psplib.hpp"
+#include "generator.hpp"
+#include "stats.hpp"
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <string>
 #include <cstdlib>
 #include <ctime>
-#include <limits>
+#include <stdexcept>
+#include <cstring>
 
 void usage( char * program_name )
 {
 	std::cout << "Usage: " << program_name << " <instance-name> [size-of-population]" << std::endl;
 }
 
+void compile( const std::string & filename )
+{
+	try
+	{
+		if ( binary::compile( filename ) )
+			std::cout << "Compiled " << filename << " into " << binary::getCacheName( filename ) << std::endl;
+		else
+			std::clog << "Cannot compile " << filename << std::endl;
+	}
+	catch ( const std::exception & e )
+	{
+		std::clog << "Invalid instance " << filename << ": " << e.what() << std::endl;
+	}
+}
+
+void generate()
+{
+	Problem p;
+
+	for ( int i = 0; i < arguments::generate_count; ++i )
+	{
+		Generator generator( arguments::random_seed + i );
+		std::string filename( arguments::filename );
+
+		generator.setNumJobs( arguments::generate_jobs );
+		generator.setNumResources( arguments::generate_resources );
+		generator.setNetworkComplexity( arguments::network_complexity );
+		generator.setResourceFactor( arguments::resource_factor );
+		generator.setResourceStrength( arguments::resource_strength );
+		generator.generate( p );
+
+		// Concatenated on the standard output without a file name
+		if ( filename.empty() )
+		{
+			psplib::write( std::cout, p );
+			continue;
+		}
+
+		// Number the files of a series before the extension
+		if ( arguments::generate_count > 1 )
+		{
+			std::string::size_type dot( filename.rfind( '.' ) ), slash( filename.rfind( '/' ) );
+			std::ostringstream number;
+
+			number << '_' << i+1;
+			if ( dot == std::string::npos || ( slash != std::string::npos && dot < slash ) )
+				dot = filename.size();
+			filename.insert( dot, number.str() );
+		}
+
+		// A compiled instance has no source
+		bool written;
+		if ( filename.size() > std::strlen( binary::extension )
+		  && filename.compare( filename.size() - std::strlen( binary::extension ), std::string::npos, binary::extension ) == 0 )
+			written = binary::save( filename, p, 0, 0 );
+		else
+		{
+			std::ofstream os( filename.c_str() );
+			psplib::write( os, p );
+			written = os;
+		}
+
+		if ( !written )
+			std::clog << "Cannot write " << filename << std::endl;
+	}
+}
+
 int main( int argc, char * argv[] )
 {
-	std::ifstream f;                   // Instance file
 	Problem p;                         // Problem parameters
-	std::vector<Solution> population;
-	int bestCmax( std::numeric_limits<int>::max() );
-	int bestIndex( 0 );
 
 
 	// Initialization ------------------------------------------------------
@@ -29,7 +102,7 @@ int main( int argc, char * argv[] )
 	arguments::parse( argc, argv );
 
 	// Print usage
-	if ( arguments::filename.empty() )
+	if ( arguments::filename.empty() && arguments::batch.empty() && arguments::generate_jobs <= 0 )
 	{
 		arguments::usage( argv[0] );
 		return 0;
@@ -40,21 +113,82 @@ int main( int argc, char * argv[] )
 	{
 		arguments::random_seed = std::time( 0 );
 	}
-	std::srand( arguments::random_seed );
 
-	// Print arguments to terminal
-	arguments::print();
+	// Generate random instances
+	if ( arguments::generate_jobs > 0 )
+	{
+		arguments::print( std::clog );
+		generate();
+		return 0;
+	}
+
+	// Solve the instances of a batch, the results are written as CSV
+	if ( !arguments::batch.empty() )
+	{
+		Batch batch;
+
+		arguments::print( std::clog );
+		if ( !batch.load( arguments::batch ) )
+		{
+			std::clog << "Invalid batch" << std::endl;
+			return 0;
+		}
 
-	// Open an instance file
-	f.open( arguments::filename.c_str() );
-	if ( !f.is_open() )
+		if ( arguments::compile )
+		{
+			for ( int i = 0; i < batch.size(); ++i )
+				compile( batch.getFilename( i ) );
+		}
+		else
+		{
+			batch.setSeed( arguments::random_seed );
+			batch.run( arguments::threads, std::cout );
+		}
+
+		if ( arguments::stats )
+			stats::report( std::clog );
+		return 0;
+	}
+
+	// Solve the instances of the standard input as they are read
+	if ( arguments::filename == "-" )
+	{
+		Pipeline pipeline( std::cin );
+
+		arguments::print( std::clog );
+		pipeline.setNumThreads( arguments::threads );
+		pipeline.setSeed( arguments::random_seed );
+		pipeline.run( std::cout );
+
+		if ( arguments::stats )
+			stats::report( std::clog );
+		return 0;
+	}
+
+	// Compile the instance into its cache
+	if ( arguments::compile )
 	{
-		std::clog << "Invalid file name" << std::endl;
+		compile( arguments::filename );
 		return 0;
 	}
 
+	// Print arguments to terminal
+	arguments::print();
+
 	// Load the problem from the instance file
-	f >> p;
+	try
+	{
+		if ( !loader::load( arguments::filename, p ) )
+		{
+			std::clog << "Invalid file name" << std::endl;
+			return 0;
+		}
+	}
+	catch ( const std::exception & e )
+	{
+		std::clog << "Invalid instance: " << e.what() << std::endl;
+		return 0;
+	}
 
 	// Display the problem
 	if ( arguments::print_problem )
@@ -67,42 +201,56 @@ int main( int argc, char * argv[] )
 
 	// Algorithm -----------------------------------------------------------
 
-	// Generate an initial population
-	for ( int i = 0; i < arguments::population_size; ++i )
-	{
-		Solution s( p );
+	// Stopping criteria shared by all the engines and threads
+	Budget budget;
 
-		// Build a solution using GRASP
-		s.grasp( arguments::alpha );
+	// GRASP population improved by the chosen engine
+	Solver solver;
+	solver.setNumThreads( arguments::threads );
+	solver.setSummary( &std::cout );
+	solver.setSeed( arguments::random_seed );
+	solver.solve( p, budget );
 
-		// Possibility to manipulate solution as following
-		//s[i] = j;
 
-		// Update changes
-		s.update();
+	// Result --------------------------------------------------------------
 
-		// We add the current solution in the population
-		population.push_back( s );
+	STATS_PHASE( Export );
 
-		if ( s.getCmax() < bestCmax )
-		{
-			bestIndex = i;
-			bestCmax = s.getCmax();
-		}
-	}
+	const Solution & best( solver.getBest() );
+	int lowerBound( solver.getLowerBound() );
 
+	std::cout << "Best solution: " << best << std::endl;
+	std::cout << "Best makespan: " << solver.getBestCmax() << std::endl;
+	std::cout << "Lower bound: " << lowerBound
+	          << " (critical path " << p.getCriticalPathBound()
+	          << ", resources " << p.getResourceBound()
+	          << ", energetic " << p.getEnergeticBound()
+	          << ", node packing " << p.getNodePackingBound()
+	          << ", time-table " << p.getTimetableBound() << ")" << std::endl;
+	std::cout << "Gap: " << 100.0 * ( solver.getBestCmax() - lowerBound ) / std::max( 1, lowerBound ) << " %" << std::endl;
+	std::cout << "Schedules: " << budget.getNumSchedules() << std::endl;
+	std::cout << "Time: " << budget.getElapsed() << " s" << std::endl;
 
-	// Result --------------------------------------------------------------
-
-	std::cout << "Best solution: " << population[bestIndex] << std::endl;
-	std::cout << "Best makespan: " << bestCmax << std::endl;
+	if ( arguments::dedup )
+		std::cout << "Duplicates rejected: " << solver.getNumDuplicates() << std::endl;
 
 	// Show the schedulings
 	if ( arguments::print_table )
-		population[bestIndex].exportTable();
+		best.exportTable();
 
 	if ( arguments::print_plot )
-		population[bestIndex].exportGnuplot();
+		best.exportGnuplot();
+
+	// Write the improvement trace
+	if ( !arguments::trace.empty() )
+	{
+		std::ofstream trace( arguments::trace.c_str() );
+		budget.exportTrace( trace );
+	}
+
+	// Instrumentation counters and phase times
+	if ( arguments::stats )
+		stats::report( std::cout );
 
 	return 0;
 }
@@ -0,0 +1,69 @@
+#include "mappedfile.hpp"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+MappedFile::MappedFile() :
+	_data( 0 ),
+	_size( 0 ),
+	_mapped( false ),
+	_buffer()
+{
+}
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+bool MappedFile::open( const std::string & filename )
+{
+	struct stat st;
+	int fd;
+
+	close();
+
+	fd = ::open( filename.c_str(), O_RDONLY );
+	if ( fd < 0 )
+		return false;
+
+	if ( fstat( fd, &st ) == 0 && S_ISREG( st.st_mode ) && st.st_size > 0 )
+	{
+		void * data = mmap( 0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+		if ( data != MAP_FAILED )
+		{
+			madvise( data, st.st_size, MADV_SEQUENTIAL );
+			_data = static_cast<const char *>( data );
+			_size = st.st_size;
+			_mapped = true;
+		}
+	}
+
+	// Not a regular file (or an empty one): read it
+	if ( !_mapped )
+	{
+		char chunk[65536];
+		ssize_t n;
+
+		while ( ( n = ::read( fd, chunk, sizeof( chunk ) ) ) > 0 )
+			_buffer.insert( _buffer.end(), chunk, chunk + n );
+
+		_data = _buffer.empty() ? 0 : &_buffer[0];
+		_size = _buffer.size();
+	}
+
+	::close( fd );
+	return true;
+}
+
+void MappedFile::close()
+{
+	if ( _mapped )
+		munmap( const_cast<char *>( _data ), _size );
+
+	_data = 0;
+	_size = 0;
+	_mapped = false;
+	_buffer.clear();
+}
@@ -0,0 +1,45 @@
+#include "patterson.hpp"
+#include "scanner.hpp"
+#include <stdexcept>
+
+const char * patterson::parse( const char * begin, const char * end, Problem & p )
+{
+	Scanner in( begin, end );
+	int numJobs( in.readInt() ), numResources( in.readInt() ), horizon( 0 );
+
+	if ( numJobs <= 0 || numResources < 0 )
+		throw std::runtime_error( "Invalid instance size" );
+
+	p.setNumJobs( numJobs );
+	p.setNumResources( numResources );
+
+	for ( int k = 0; k < numResources; ++k )
+		p.setResourceCapacity( k, in.readInt() );
+
+	// Jobs in order: duration, requests, successors
+	for ( int j = 0; j < numJobs; ++j )
+	{
+		int numSuccessors;
+
+		p.setJobDuration( j, in.readInt() );
+		horizon += p.getJobDuration( j );
+
+		for ( int k = 0; k < numResources; ++k )
+			p.setJobRequest( j, k, in.readInt() );
+
+		numSuccessors = in.readInt();
+		for ( int k = 0; k < numSuccessors; ++k )
+		{
+			int s( in.readInt() );
+			if ( s < 1 || s > numJobs )
+				throw std::runtime_error( "Invalid successor" );
+			p.addJobSuccessor( j, s-1 );
+		}
+	}
+
+	// No horizon in the format: the sum of the durations
+	p.setHorizon( horizon );
+
+	p.preprocess();
+	return in.getPosition();
+}
@@ -0,0 +1,137 @@
+#include "pipeline.hpp"
+#include "solver.hpp"
+#include "budget.hpp"
+#include "threadpool.hpp"
+#include "psplib.hpp"
+#include "stats.hpp"
+#include <stdexcept>
+
+/*
+	The reader thread of the pipeline.
+*/
+class ReaderTask : public Task
+{
+public:
+	ReaderTask( Pipeline * pipeline ) :
+		_pipeline( pipeline )
+	{
+	}
+
+	void run()
+	{
+		_pipeline->read();
+	}
+
+private:
+	Pipeline * _pipeline;
+};
+
+Pipeline::Pipeline( std::istream & is ) :
+	_is( is ),
+	_numThreads( 0 ),
+	_seed( 1 ),
+	_end( false )
+{
+	_state[0] = _state[1] = Free;
+	pthread_mutex_init( &_mutex, 0 );
+	pthread_cond_init( &_changed, 0 );
+}
+
+Pipeline::~Pipeline()
+{
+	pthread_cond_destroy( &_changed );
+	pthread_mutex_destroy( &_mutex );
+}
+
+void Pipeline::read()
+{
+	std::string text;
+
+	for ( int i = 0; ; ++i )
+	{
+		int slot( i % 2 ), state( Ready );
+
+		// Wait until the problem read two instances ago is solved
+		pthread_mutex_lock( &_mutex );
+		while ( _state[slot] != Free )
+		{
+			pthread_cond_wait( &_changed, &_mutex );
+		}
+		pthread_mutex_unlock( &_mutex );
+
+		if ( !psplib::extract( _is, text ) )
+			break;
+
+		try
+		{
+			psplib::parse( text.data(), text.data() + text.size(), _problems[slot] );
+		}
+		catch ( const std::exception & e )
+		{
+			_error[slot] = e.what();
+			state = Invalid;
+		}
+
+		pthread_mutex_lock( &_mutex );
+		_state[slot] = state;
+		pthread_cond_broadcast( &_changed );
+		pthread_mutex_unlock( &_mutex );
+	}
+
+	pthread_mutex_lock( &_mutex );
+	_end = true;
+	pthread_cond_broadcast( &_changed );
+	pthread_mutex_unlock( &_mutex );
+}
+
+void Pipeline::run( std::ostream & os )
+{
+	ThreadPool pool( 1 );
+	ReaderTask reader( this );
+	Solver solver;
+
+	os << "instance,lower_bound,makespan,time,schedules" << std::endl;
+
+	solver.setNumThreads( _numThreads );
+	pool.push( &reader );
+
+	for ( int i = 0; ; ++i )
+	{
+		int slot( i % 2 ), state;
+
+		pthread_mutex_lock( &_mutex );
+		while ( _state[slot] == Free && !_end )
+		{
+			pthread_cond_wait( &_changed, &_mutex );
+		}
+		state = _state[slot];
+		pthread_mutex_unlock( &_mutex );
+
+		// The reader ended without another instance
+		if ( state == Free )
+			break;
+
+		if ( state == Ready )
+		{
+			Budget budget;
+			solver.setSeed( _seed + i );
+			solver.solve( _problems[slot], budget );
+
+			STATS_PHASE( Export );
+			os << i+1 << ','
+			   << solver.getLowerBound() << ','
+			   << solver.getBestCmax() << ','
+			   << budget.getElapsed() << ','
+			   << budget.getNumSchedules() << std::endl;
+		}
+		else
+			std::clog << "Invalid instance " << i+1 << ": " << _error[slot] << std::endl;
+
+		pthread_mutex_lock( &_mutex );
+		_state[slot] = Free;
+		pthread_cond_broadcast( &_changed );
+		pthread_mutex_unlock( &_mutex );
+	}
+
+	pool.wait();
+}
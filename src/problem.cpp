@@ -1,18 +1,34 @@
 #include "problem.hpp"
+#include "propagator.hpp"
+#include "psplib.hpp"
+#include "stats.hpp"
 #include "pstream.h"
 #include <sstream>
+#include <iterator>
 #include <stdexcept>
 #include <iomanip>
 #include <cmath>
+#include <cstdlib>
+
+// Beyond this number of jobs, the bounds in O(n^2) memory or time are skipped
+static const int maxBoundJobs( 500 );
 
 Problem::Problem() :
 	_numJobs( 1 ),
 	_numResources( 1 ),
+	_horizon( 0 ),
+	_criticalPathBound( 0 ),
+	_resourceBound( 0 ),
+	_energeticBound( 0 ),
+	_nodePackingBound( 0 ),
+	_timetableBound( 0 ),
+	_heuristicBound( 0 ),
 	_resourceCapacity( 1 ),
 	_jobDuration( 1 ),
 	_jobRequest( 1, std::vector<int>( 1 ) ),
 	_jobPredecessors( 1 ),
-	_jobSuccessors( 1 )
+	_jobSuccessors( 1 ),
+	_closureWords( 0 )
 {
 }
 
@@ -28,10 +44,392 @@ int Problem::getUpperBound() const
 	return std::max( sum, max );
 }
 
+void Problem::preprocess()
+{
+	STATS_PHASE( Init );
+	computeWindows();
+	computeClosure();
+	computeBounds();
+}
+
+void Problem::computeWindows()
+{
+	std::vector<int> degree( _numJobs );
+	std::vector<int> & order( _topologicalOrder );
+
+	// Topological order of the precedence graph (Kahn)
+	order.clear();
+	for ( int j = 0; j < _numJobs; ++j )
+	{
+		degree[j] = _jobPredecessors[j].size();
+		if ( degree[j] == 0 )
+			order.push_back( j );
+	}
+	for ( int i = 0; i < (int)order.size(); ++i )
+	{
+		int j = order[i];
+		for ( int k = 0; k < (int)_jobSuccessors[j].size(); ++k )
+		{
+			int s = _jobSuccessors[j][k];
+			if ( --degree[s] == 0 )
+				order.push_back( s );
+		}
+	}
+
+	// The jobs of a cycle never lose their last predecessor
+	if ( (int)order.size() != _numJobs )
+		throw std::runtime_error( "Cyclic precedences" );
+
+	// Heads along the topological order (forward pass)...
+	_jobHead.assign( _numJobs, 0 );
+	for ( int i = 0; i < (int)order.size(); ++i )
+	{
+		int j = order[i], f = _jobHead[j] + _jobDuration[j];
+		for ( int k = 0; k < (int)_jobSuccessors[j].size(); ++k )
+		{
+			int s = _jobSuccessors[j][k];
+			_jobHead[s] = std::max( _jobHead[s], f );
+		}
+	}
+
+	// ... and tails in the reverse order (backward pass)
+	_jobTail.assign( _numJobs, 0 );
+	for ( int i = (int)order.size()-1; i >= 0; --i )
+	{
+		int j = order[i];
+		for ( int k = 0; k < (int)_jobSuccessors[j].size(); ++k )
+		{
+			int s = _jobSuccessors[j][k];
+			_jobTail[j] = std::max( _jobTail[j], _jobDuration[s] + _jobTail[s] );
+		}
+	}
+}
+
+void Problem::computeClosure()
+{
+	const int bits = 8 * sizeof( unsigned long );
+
+	_closureWords = ( _numJobs + bits - 1 ) / bits;
+	_closure.assign( _numJobs * _closureWords, 0 );
+
+	// The rows of the successors are complete when a job is reached
+	for ( int i = (int)_topologicalOrder.size()-1; i >= 0; --i )
+	{
+		int j = _topologicalOrder[i];
+		unsigned long * row = &_closure[j * _closureWords];
+
+		for ( int k = 0; k < (int)_jobSuccessors[j].size(); ++k )
+		{
+			int s = _jobSuccessors[j][k];
+			const unsigned long * succ = &_closure[s * _closureWords];
+
+			for ( int w = 0; w < _closureWords; ++w )
+			{
+				row[w] |= succ[w];
+			}
+			row[s / bits] |= 1UL << ( s % bits );
+		}
+	}
+}
+
+void Problem::computeBounds()
+{
+	// Longest path
+	_criticalPathBound = 0;
+	for ( int j = 0; j < _numJobs; ++j )
+	{
+		_criticalPathBound = std::max( _criticalPathBound, _jobHead[j] + _jobDuration[j] );
+	}
+
+	// Energy of each resource, rounded up to full periods
+	_resourceBound = 0;
+	for ( int k = 0; k < _numResources; ++k )
+	{
+		int energy( 0 );
+		for ( int j = 0; j < _numJobs; ++j )
+		{
+			energy += _jobDuration[j] * _jobRequest[j][k];
+		}
+		if ( _resourceCapacity[k] > 0 )
+			_resourceBound = std::max( _resourceBound, ( energy + _resourceCapacity[k] - 1 ) / _resourceCapacity[k] );
+	}
+
+	_heuristicBound = computeHeuristicBound();
+
+	// Latest start times for the heuristic bound, tightened by propagation
+	_jobLatestStart.clear();
+	{
+		Propagator propagator( *this );
+		if ( propagator.initialize( _heuristicBound ) )
+		{
+			for ( int j = 0; j < _numJobs; ++j )
+				_jobLatestStart.push_back( propagator.getLatestStart( j ) );
+		}
+	}
+
+	// The expensive bounds, computed serially: the instances of a batch are
+	// already solved in parallel, and a thread pool per instance costs more
+	// than these bounds on small instances (the large ones are skipped)
+	_energeticBound = computeEnergeticBound();
+	_nodePackingBound = computeNodePackingBound();
+	_timetableBound = computeTimetableBound();
+}
+
+int Problem::computeTimetableBound() const
+{
+	Propagator propagator( *this );
+	int lo( std::max( _criticalPathBound, _resourceBound ) ), hi( std::max( lo, _heuristicBound ) );
+
+	// Binary search: the propagation fails for all the makespans below the bound
+	while ( lo < hi )
+	{
+		int mid( ( lo + hi ) / 2 );
+		if ( propagator.initialize( mid ) )
+			hi = mid;
+		else
+			lo = mid + 1;
+	}
+	return lo;
+}
+
+int Problem::computeHeuristicBound() const
+{
+	std::vector<int> degree( _numJobs ), eligible, finish( _numJobs );
+	std::vector< std::vector<int> > usage( _numResources ); // usage[k][t], grown on demand
+	int cmax( 0 );
+
+	for ( int j = 0; j < _numJobs; ++j )
+	{
+		degree[j] = _jobPredecessors[j].size();
+		if ( degree[j] == 0 )
+			eligible.push_back( j );
+	}
+
+	while ( !eligible.empty() )
+	{
+		// Latest finish time rule: the longest tail first
+		int e( 0 );
+		for ( int i = 1; i < (int)eligible.size(); ++i )
+		{
+			if ( _jobTail[eligible[i]] > _jobTail[eligible[e]] )
+				e = i;
+		}
+		int j = eligible[e], d = _jobDuration[j], t = 0;
+		eligible.erase( eligible.begin() + e );
+
+		for ( int k = 0; k < (int)_jobPredecessors[j].size(); ++k )
+		{
+			t = std::max( t, finish[_jobPredecessors[j][k]] );
+		}
+
+		// Leftmost start time with enough capacity during d periods
+		for ( int u = t; u < t+d; ++u )
+		{
+			for ( int k = 0; k < _numResources; ++k )
+			{
+				if ( u < (int)usage[k].size() && usage[k][u] + _jobRequest[j][k] > _resourceCapacity[k] )
+				{
+					t = u+1;
+					break;
+				}
+			}
+		}
+
+		for ( int k = 0; k < _numResources; ++k )
+		{
+			if ( (int)usage[k].size() < t+d )
+				usage[k].resize( t+d, 0 );
+
+			for ( int u = t; u < t+d; ++u )
+			{
+				usage[k][u] += _jobRequest[j][k];
+			}
+		}
+
+		finish[j] = t+d;
+		cmax = std::max( cmax, t+d );
+
+		for ( int k = 0; k < (int)_jobSuccessors[j].size(); ++k )
+		{
+			int s = _jobSuccessors[j][k];
+			if ( --degree[s] == 0 )
+				eligible.push_back( s );
+		}
+	}
+	return cmax;
+}
+
+bool Problem::isEnergyFeasible( int T ) const
+{
+	std::vector<int> starts, ends, energy( _numResources ), slope( _numResources );
+	std::vector< std::pair<int,int> > events;
+
+	// Relevant intervals: bounded by the earliest and latest start and finish times
+	for ( int j = 0; j < _numJobs; ++j )
+	{
+		int es = _jobHead[j], ls = T - _jobTail[j] - _jobDuration[j];
+
+		// Empty time window
+		if ( ls < es )
+			return false;
+
+		starts.push_back( es );
+		starts.push_back( ls );
+		ends.push_back( es + _jobDuration[j] );
+		ends.push_back( ls + _jobDuration[j] );
+	}
+	std::sort( starts.begin(), starts.end() );
+	starts.erase( std::unique( starts.begin(), starts.end() ), starts.end() );
+	std::sort( ends.begin(), ends.end() );
+	ends.erase( std::unique( ends.begin(), ends.end() ), ends.end() );
+
+	for ( int a = 0; a < (int)starts.size(); ++a )
+	{
+		int t1 = starts[a];
+
+		// Minimal part of j inside [t1,t2) as t2 grows: none until max(t1,ls),
+		// then one more unit per period up to min(d,es+d-t1). The energy is
+		// piecewise linear in t2, its slope changes at these events (job j+1
+		// for a rise, -(j+1) for the end of a rise).
+		events.clear();
+		for ( int j = 0; j < _numJobs; ++j )
+		{
+			int es = _jobHead[j], ls = T - _jobTail[j] - _jobDuration[j], d = _jobDuration[j];
+			int from = std::max( t1, ls ), part = std::min( d, es + d - t1 );
+			if ( part <= 0 )
+				continue;
+
+			events.push_back( std::make_pair( from, j+1 ) );
+			events.push_back( std::make_pair( from + part, -(j+1) ) );
+		}
+		std::sort( events.begin(), events.end() );
+
+		// Sweep the ends of the intervals, updating the energy incrementally
+		std::fill( energy.begin(), energy.end(), 0 );
+		std::fill( slope.begin(), slope.end(), 0 );
+		int now = t1, e = 0;
+
+		for ( int b = 0; b < (int)ends.size(); ++b )
+		{
+			int t2 = ends[b];
+			if ( t2 <= t1 )
+				continue;
+
+			for ( ; e < (int)events.size() && events[e].first <= t2; ++e )
+			{
+				int j = std::abs( events[e].second ) - 1, sign = events[e].second > 0 ? 1 : -1;
+				for ( int k = 0; k < _numResources; ++k )
+				{
+					energy[k] += slope[k] * ( events[e].first - now );
+					slope[k] += sign * _jobRequest[j][k];
+				}
+				now = events[e].first;
+			}
+
+			for ( int k = 0; k < _numResources; ++k )
+			{
+				energy[k] += slope[k] * ( t2 - now );
+				if ( energy[k] > _resourceCapacity[k] * ( t2 - t1 ) )
+					return false;
+			}
+			now = t2;
+		}
+	}
+	return true;
+}
+
+int Problem::computeEnergeticBound() const
+{
+	int lo( std::max( _criticalPathBound, _resourceBound ) ), hi( getUpperBound() );
+
+	// O(n^3) per test: too slow beyond a few hundred jobs
+	if ( _numJobs > maxBoundJobs )
+		return lo;
+
+	// Smallest feasible T (the test is monotone: a larger T only widens the windows)
+	if ( isEnergyFeasible( lo ) )
+		return lo;
+
+	while ( hi - lo > 1 )
+	{
+		int T = lo + ( hi - lo ) / 2;
+		if ( isEnergyFeasible( T ) )
+			hi = T;
+		else
+			lo = T;
+	}
+	return hi;
+}
+
+int Problem::computeNodePackingBound() const
+{
+	// An n*n matrix built in O(n^2 R): skipped with the energetic bound
+	if ( _numJobs > maxBoundJobs )
+		return 0;
+
+	std::vector<char> incompatible( _numJobs * _numJobs, 0 );
+	std::vector< std::pair<int,int> > order;
+	std::vector<int> clique;
+	int best( 0 );
+
+	// Two jobs are incompatible if one precedes the other or if they overload a resource together
+	for ( int i = 0; i < _numJobs; ++i )
+	{
+		for ( int j = i+1; j < _numJobs; ++j )
+		{
+			if ( isJobPredecessor( i, j ) || isJobPredecessor( j, i ) )
+			{
+				incompatible[i * _numJobs + j] = incompatible[j * _numJobs + i] = 1;
+				continue;
+			}
+
+			for ( int k = 0; k < _numResources; ++k )
+			{
+				if ( _jobRequest[i][k] + _jobRequest[j][k] > _resourceCapacity[k] )
+				{
+					incompatible[i * _numJobs + j] = incompatible[j * _numJobs + i] = 1;
+					break;
+				}
+			}
+		}
+
+		if ( _jobDuration[i] > 0 )
+			order.push_back( std::make_pair( -_jobDuration[i], i ) );
+	}
+	std::sort( order.begin(), order.end() );
+
+	// Greedy cliques of incompatible jobs, each one seeded by one of the longest jobs
+	for ( int seed = 0; seed < (int)order.size() && seed < 64; ++seed )
+	{
+		int sum( -order[seed].first );
+
+		clique.assign( 1, order[seed].second );
+		for ( int i = 0; i < (int)order.size(); ++i )
+		{
+			int j = order[i].second;
+			bool fits( i != seed );
+
+			for ( int c = 0; c < (int)clique.size() && fits; ++c )
+			{
+				fits = incompatible[j * _numJobs + clique[c]];
+			}
+
+			if ( fits )
+			{
+				clique.push_back( j );
+				sum += _jobDuration[j];
+			}
+		}
+
+		best = std::max( best, sum );
+	}
+	return best;
+}
+
 void Problem::setNumJobs( int jmax )
 {
 	_numJobs = jmax;
-	_jobDuration.resize( _numJobs );
+	_jobDuration.assign( _numJobs, 0 );
 	_jobRequest.clear();
 	_jobRequest.resize( _numJobs, std::vector<int>( _numResources ) );
 	_jobPredecessors.clear();
@@ -43,7 +441,7 @@ void Problem::setNumJobs( int jmax )
 void Problem::setNumResources( int rmax )
 {
 	_numResources = rmax;
-	_resourceCapacity.resize( _numResources );
+	_resourceCapacity.assign( _numResources, 0 );
 	_jobRequest.clear();
 	_jobRequest.resize( _numJobs, std::vector<int>( _numResources ) );
 }
@@ -72,17 +470,6 @@ void Problem::exportDotPrecedenceGraph( std::ostream & os ) const
 	os << '}' << std::endl;
 }
 
-// Read a value on a line in the form "  key  :  value  "
-int Problem::readValue( const std::string & line )
-{
-	std::size_t pos;
-	int i;
-
-	pos = line.find( ':' );
-	std::istringstream( line.substr( pos+1 ) ) >> i;
-	return i;
-}
-
 // Show on terminal or output
 std::ostream & operator << ( std::ostream & os, const Problem & p )
 {
@@ -138,120 +525,13 @@ std::ostream & operator << ( std::ostream & os, const Problem & p )
 // Load from a file or input
 std::istream & operator >> ( std::istream & is, Problem & p )
 {
-	int state = 0;
-
-	for ( std::string line; std::getline( is, line ); )
-	{
-		switch ( state )
-		{
-			default: // Headers
-				if ( line.find( "projects" ) != std::string::npos )
-				{
-					if ( Problem::readValue( line ) != 1 )
-					{
-						throw std::logic_error( "Number of projects is greater than supported" );
-					}
-				}
-
-				else if ( line.find( "jobs" ) != std::string::npos )
-				{
-					p.setNumJobs( Problem::readValue( line ) );
-				}
-
-				else if ( line.find( "horizon" ) != std::string::npos )
-				{
-					p.setHorizon( Problem::readValue( line ) );
-				}
-
-				else if ( line.find( "- renewable" ) != std::string::npos )
-				{
-					p.setNumResources( Problem::readValue( line ) );
-				}
-
-				else if ( line.find( "PROJECT INFORMATION" ) != std::string::npos )
-				{
-					state = 1;
-				}
-
-				else if ( line.find( "PRECEDENCE RELATIONS" ) != std::string::npos )
-				{
-					state = 2;
-				}
-
-				else if ( line.find( "REQUESTS/DURATIONS" ) != std::string::npos )
-				{
-					state = 3;
-				}
-
-				else if ( line.find( "RESOURCEAVAILABILITIES" ) != std::string::npos )
-				{
-					state = 4;
-				}
-				break;
-
-			case 1: // PROJECT INFORMATION
-				int pronr, njobs, reldate, duedate, tardcost, MPM_Time;
-
-				if ( std::getline( is, line ) ) // Skip the first line
-				{
-					std::istringstream( line )
-						>> pronr >> njobs >> reldate >> duedate >> tardcost >> MPM_Time;
-					p.setNumJobs( njobs+2 );
-				}
-				state = 0;
-				break;
-
-			case 2:{ // PRECEDENCE RELATIONS
-				int jobnr, nmodes, nsuccessors, succ;
+	// Read the next instance of the stream in a buffer for the PSPLIB reader
+	std::string buffer;
 
-				for ( int j = 0; j < p.getNumJobs() && std::getline( is, line ); ++j )
-				{
-					std::istringstream iss( line );
-					iss >> jobnr >> nmodes >> nsuccessors;
-					for ( int i = 0; i < nsuccessors; ++i )
-					{
-						iss >> succ;
-						p.addJobSuccessor( jobnr-1, succ-1 );
-					}
-				}
-				state = 0;
-				}break;
-
-			case 3:{ // REQUESTS/DURATIONS
-				int jobnr, mode, duration, req;
-
-				if ( std::getline( is, line ) ) // Skip the first line
-				{
-					for ( int j = 0; j < p.getNumJobs() && std::getline( is, line ); ++j )
-					{
-						std::istringstream iss( line );
-						iss >> jobnr >> mode >> duration;
-						p.setJobDuration( jobnr-1, duration );
-						for ( int k = 0; k < p.getNumResources(); ++k )
-						{
-							iss >> req;
-							p.setJobRequest( jobnr-1, k, req );
-						}
-					}
-				}
-				state = 0;
-				}break;
-
-			case 4: // RESOURCEAVAILABILITIES
-				if ( std::getline( is, line ) ) // Skip the first line
-				{
-					std::istringstream iss( line );
-					for ( int k = 0; k < p.getNumResources(); ++k )
-					{
-						int c;
-						iss >> c;
-						p.setResourceCapacity( k, c );
-					}
-				}
-				state = 0;
-				break;
-		}
-	}
+	if ( psplib::extract( is, buffer ) )
+		psplib::parse( buffer.data(), buffer.data() + buffer.size(), p );
+	else
+		is.setstate( std::ios::failbit );
 	return is;
 }
 
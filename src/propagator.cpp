@@ -0,0 +1,261 @@
+#include "propagator.hpp"
+#include <algorithm>
+
+Propagator::Propagator( const Problem & p ) :
+	_problem( p ),
+	_numJobs( p.getNumJobs() ),
+	_numResources( p.getNumResources() ),
+	_deadline( 0 ),
+	_est( p.getNumJobs() ),
+	_lst( p.getNumJobs() ),
+	_profile(),
+	_precedenceQueue(),
+	_timetableQueue(),
+	_precedenceQueued( p.getNumJobs() ),
+	_timetableQueued( p.getNumJobs() )
+{
+	// A job is queued at most once
+	_precedenceQueue.reserve( _numJobs );
+	_timetableQueue.reserve( _numJobs );
+}
+
+bool Propagator::initialize( int deadline )
+{
+	_deadline = deadline;
+	_trailJob.clear();
+	_trailEst.clear();
+	_trailLst.clear();
+	clearQueues();
+	_profile.assign( std::max( deadline, 0 ) * _numResources, 0 );
+
+	// CPM windows
+	for ( int j = 0; j < _numJobs; ++j )
+	{
+		_est[j] = _problem.getJobEarliestStart( j );
+		_lst[j] = deadline - _problem.getJobTail( j ) - _problem.getJobDuration( j );
+		if ( _est[j] > _lst[j] )
+			return false;
+	}
+
+	// They are consistent with the precedences, but not with the resources
+	for ( int j = 0; j < _numJobs; ++j )
+	{
+		addCompulsoryPart( j, _est[j], _lst[j], 1 );
+		_timetableQueue.push_back( j );
+		_timetableQueued[j] = 1;
+	}
+
+	if ( !propagate() )
+	{
+		clearQueues();
+		return false;
+	}
+	return true;
+}
+
+bool Propagator::setStartTime( int j, int t )
+{
+	if ( !tighten( j, t, t ) || !propagate() )
+	{
+		clearQueues();
+		return false;
+	}
+	return true;
+}
+
+bool Propagator::setEarliestStart( int j, int t )
+{
+	if ( !tighten( j, t, _lst[j] ) || !propagate() )
+	{
+		clearQueues();
+		return false;
+	}
+	return true;
+}
+
+void Propagator::undo( int mark )
+{
+	clearQueues();
+	while ( (int)_trailJob.size() > mark )
+	{
+		int j( _trailJob.back() );
+
+		addCompulsoryPart( j, _est[j], _lst[j], -1 );
+		_est[j] = _trailEst.back();
+		_lst[j] = _trailLst.back();
+		addCompulsoryPart( j, _est[j], _lst[j], 1 );
+
+		_trailJob.pop_back();
+		_trailEst.pop_back();
+		_trailLst.pop_back();
+	}
+}
+
+bool Propagator::tighten( int j, int est, int lst )
+{
+	int d( _problem.getJobDuration( j ) ),
+	    oldEst( _est[j] ),
+	    oldLst( _lst[j] );
+
+	est = std::max( est, oldEst );
+	lst = std::min( lst, oldLst );
+	if ( est == oldEst && lst == oldLst )
+		return true;
+
+	_trailJob.push_back( j );
+	_trailEst.push_back( oldEst );
+	_trailLst.push_back( oldLst );
+
+	addCompulsoryPart( j, oldEst, oldLst, -1 );
+	_est[j] = est;
+	_lst[j] = lst;
+	addCompulsoryPart( j, est, lst, 1 );
+
+	// The compulsory part grows on both sides: the jobs around have less capacity
+	if ( d > 0 && lst < est + d )
+		queueOverlapping( j, lst, est + d );
+
+	if ( !_precedenceQueued[j] )
+	{
+		_precedenceQueue.push_back( j );
+		_precedenceQueued[j] = 1;
+	}
+
+	if ( !_timetableQueued[j] )
+	{
+		_timetableQueue.push_back( j );
+		_timetableQueued[j] = 1;
+	}
+
+	return est <= lst;
+}
+
+bool Propagator::propagate()
+{
+	for ( ;; )
+	{
+		// The precedences first, they are cheaper
+		if ( !_precedenceQueue.empty() )
+		{
+			int j( _precedenceQueue.back() );
+			_precedenceQueue.pop_back();
+			_precedenceQueued[j] = 0;
+
+			const std::vector<int> & successors( _problem.getJobSuccessors( j ) ),
+			                       & predecessors( _problem.getJobPredecessors( j ) );
+
+			for ( int i = 0; i < (int)successors.size(); ++i )
+			{
+				int s( successors[i] );
+				if ( !tighten( s, _est[j] + _problem.getJobDuration( j ), _lst[s] ) )
+					return false;
+			}
+
+			for ( int i = 0; i < (int)predecessors.size(); ++i )
+			{
+				int q( predecessors[i] );
+				if ( !tighten( q, _est[q], _lst[j] - _problem.getJobDuration( q ) ) )
+					return false;
+			}
+		}
+		else if ( !_timetableQueue.empty() )
+		{
+			int j( _timetableQueue.back() );
+			_timetableQueue.pop_back();
+			_timetableQueued[j] = 0;
+
+			if ( !filter( j ) )
+				return false;
+		}
+		else
+		{
+			return true;
+		}
+	}
+}
+
+bool Propagator::filter( int j )
+{
+	int d( _problem.getJobDuration( j ) ),
+	    est( _est[j] ),
+	    lst( _lst[j] );
+
+	if ( d == 0 )
+		return true;
+
+	// Earliest start: move after each period without enough capacity...
+	for ( int u = est; est <= lst && u < est + d; ++u )
+	{
+		if ( !fits( j, u ) )
+			est = u + 1;
+	}
+
+	// ... latest start: move before them
+	for ( int u = lst + d - 1; est <= lst && u >= lst; --u )
+	{
+		if ( !fits( j, u ) )
+			lst = u - d;
+	}
+
+	return tighten( j, est, lst );
+}
+
+bool Propagator::fits( int j, int u ) const
+{
+	int d( _problem.getJobDuration( j ) );
+	bool compulsory( u >= _lst[j] && u < _est[j] + d );
+
+	for ( int k = 0; k < _numResources; ++k )
+	{
+		int req( _problem.getJobRequest( j, k ) ),
+		    usage( _profile[u * _numResources + k] - ( compulsory ? req : 0 ) );
+
+		if ( req > 0 && usage + req > _problem.getResourceCapacity( k ) )
+			return false;
+	}
+	return true;
+}
+
+void Propagator::addCompulsoryPart( int j, int est, int lst, int sign )
+{
+	int end( std::min( est + _problem.getJobDuration( j ), _deadline ) );
+
+	for ( int u = std::max( lst, 0 ); u < end; ++u )
+	{
+		for ( int k = 0; k < _numResources; ++k )
+			_profile[u * _numResources + k] += sign * _problem.getJobRequest( j, k );
+	}
+}
+
+void Propagator::queueOverlapping( int j, int a, int b )
+{
+	for ( int i = 0; i < _numJobs; ++i )
+	{
+		int d( _problem.getJobDuration( i ) );
+
+		if ( i == j || _timetableQueued[i] || d == 0 || _est[i] >= b || _lst[i] + d <= a )
+			continue;
+
+		// Only the jobs sharing a resource are concerned
+		for ( int k = 0; k < _numResources; ++k )
+		{
+			if ( _problem.getJobRequest( i, k ) > 0 && _problem.getJobRequest( j, k ) > 0 )
+			{
+				_timetableQueue.push_back( i );
+				_timetableQueued[i] = 1;
+				break;
+			}
+		}
+	}
+}
+
+void Propagator::clearQueues()
+{
+	for ( int i = 0; i < (int)_precedenceQueue.size(); ++i )
+		_precedenceQueued[_precedenceQueue[i]] = 0;
+	for ( int i = 0; i < (int)_timetableQueue.size(); ++i )
+		_timetableQueued[_timetableQueue[i]] = 0;
+
+	_precedenceQueue.clear();
+	_timetableQueue.clear();
+}
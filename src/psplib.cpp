@@ -0,0 +1,202 @@
+#include "psplib.hpp"
+#include "scanner.hpp"
+#include "stats.hpp"
+#include <stdexcept>
+#include <iomanip>
+
+const char * psplib::parse( const char * begin, const char * end, Problem & p )
+{
+	STATS_PHASE( Parse );
+	Scanner in( begin, end );
+	int numJobs, numResources;
+
+	// Headers
+	if ( !in.find( "projects" ) )
+		throw std::runtime_error( "Not a PSPLIB instance" );
+
+	if ( in.readValue() != 1 )
+		throw std::logic_error( "Number of projects is greater than supported" );
+
+	in.find( "jobs" );
+	numJobs = in.readValue();
+
+	in.find( "horizon" );
+	p.setHorizon( in.readValue() );
+
+	in.find( "renewable" );
+	numResources = in.readValue();
+
+	if ( numJobs <= 0 || numResources < 0 )
+		throw std::runtime_error( "Invalid instance size" );
+
+	p.setNumJobs( numJobs );
+	p.setNumResources( numResources );
+
+	// Successors of each job, after the title and the column labels
+	if ( !in.find( "PRECEDENCE RELATIONS" ) )
+		throw std::runtime_error( "Missing precedence relations" );
+	in.skipLine();
+	in.skipLine();
+
+	for ( int i = 0; i < numJobs; ++i )
+	{
+		int j( in.readInt() ), modes( in.readInt() ), numSuccessors( in.readInt() );
+
+		if ( j < 1 || j > numJobs || modes != 1 )
+			throw std::runtime_error( "Invalid precedence relation" );
+
+		for ( int k = 0; k < numSuccessors; ++k )
+		{
+			int s( in.readInt() );
+			if ( s < 1 || s > numJobs )
+				throw std::runtime_error( "Invalid successor" );
+			p.addJobSuccessor( j-1, s-1 );
+		}
+	}
+
+	// Durations and requests, after the title, the column labels (which
+	// contain the resource numbers) and the dashes
+	if ( !in.find( "REQUESTS/DURATIONS" ) )
+		throw std::runtime_error( "Missing requests and durations" );
+	in.skipLine();
+	in.skipLine();
+	in.skipLine();
+
+	for ( int i = 0; i < numJobs; ++i )
+	{
+		int j( in.readInt() );
+
+		if ( j < 1 || j > numJobs )
+			throw std::runtime_error( "Invalid job number" );
+
+		in.readInt(); // Mode
+		int duration( in.readInt() );
+		if ( duration < 0 )
+			throw std::runtime_error( "Invalid duration" );
+		p.setJobDuration( j-1, duration );
+
+		for ( int k = 0; k < numResources; ++k )
+		{
+			int request( in.readInt() );
+			if ( request < 0 )
+				throw std::runtime_error( "Invalid request" );
+			p.setJobRequest( j-1, k, request );
+		}
+	}
+
+	// Capacities, after the title and the column labels
+	if ( !in.find( "RESOURCEAVAILABILITIES" ) )
+		throw std::runtime_error( "Missing resource availabilities" );
+	in.skipLine();
+	in.skipLine();
+
+	for ( int k = 0; k < numResources; ++k )
+	{
+		int capacity( in.readInt() );
+		if ( capacity < 0 )
+			throw std::runtime_error( "Invalid capacity" );
+		p.setResourceCapacity( k, capacity );
+	}
+	in.skipLine();
+
+	// A job requesting more than a capacity can never be scheduled
+	for ( int j = 0; j < numJobs; ++j )
+	{
+		for ( int k = 0; k < numResources; ++k )
+		{
+			if ( p.getJobRequest( j, k ) > p.getResourceCapacity( k ) )
+				throw std::runtime_error( "Request above the capacity" );
+		}
+	}
+
+	p.preprocess();
+	return in.getPosition();
+}
+
+bool psplib::extract( std::istream & is, std::string & text )
+{
+	STATS_PHASE( Parse );
+	std::string line;
+	bool availabilities( false ), empty( true );
+
+	text.clear();
+	while ( std::getline( is, line ) )
+	{
+		text += line;
+		text += '\n';
+
+		// The banner after the capacities closes the instance
+		if ( availabilities && line.compare( 0, 4, "****" ) == 0 )
+			return true;
+
+		if ( line.find( "RESOURCEAVAILABILITIES" ) != std::string::npos )
+			availabilities = true;
+
+		if ( line.find_first_not_of( " \t\r*" ) != std::string::npos )
+			empty = false;
+	}
+
+	// The last instance may end without a banner
+	return !empty;
+}
+
+void psplib::write( std::ostream & os, const Problem & p )
+{
+	const std::string banner( 72, '*' );
+	const int n( p.getNumJobs() ), m( p.getNumResources() );
+
+	os
+		<< banner << std::endl
+		<< "projects                      :  1" << std::endl
+		<< "jobs (incl. supersource/sink ):  " << n << std::endl
+		<< "horizon                       :  " << p.getHorizon() << std::endl
+		<< "RESOURCES" << std::endl
+		<< "  - renewable                 :  " << m << "   R" << std::endl
+		<< "  - nonrenewable              :  0   N" << std::endl
+		<< "  - doubly constrained        :  0   D" << std::endl
+		<< banner << std::endl
+		<< "PROJECT INFORMATION:" << std::endl
+		<< "pronr.  #jobs rel.date duedate tardcost  MPM-Time" << std::endl
+		<< "    1 " << std::setw( 6 ) << n - 2 << "      0 " << std::setw( 7 ) << p.getCriticalPathBound()
+		<< "        0 " << std::setw( 7 ) << p.getCriticalPathBound() << std::endl
+		<< banner << std::endl
+		<< "PRECEDENCE RELATIONS:" << std::endl
+		<< "jobnr.    #modes  #successors   successors" << std::endl;
+
+	for ( int j = 0; j < n; ++j )
+	{
+		const std::vector<int> & successors( p.getJobSuccessors( j ) );
+
+		// A space before every field keeps the numbers apart when they fill their width
+		os << std::setw( 4 ) << j+1 << "        1" << ' ' << std::setw( 10 ) << successors.size() << "     ";
+		for ( int k = 0; k < (int)successors.size(); ++k )
+			os << ' ' << std::setw( 4 ) << successors[k]+1;
+		os << std::endl;
+	}
+
+	os
+		<< banner << std::endl
+		<< "REQUESTS/DURATIONS:" << std::endl
+		<< "jobnr. mode duration ";
+	for ( int k = 0; k < m; ++k )
+		os << " R " << k+1;
+	os << std::endl << std::string( 72, '-' ) << std::endl;
+
+	for ( int j = 0; j < n; ++j )
+	{
+		os << std::setw( 3 ) << j+1 << "      1" << ' ' << std::setw( 5 ) << p.getJobDuration( j ) << "  ";
+		for ( int k = 0; k < m; ++k )
+			os << ' ' << std::setw( 4 ) << p.getJobRequest( j, k );
+		os << std::endl;
+	}
+
+	os
+		<< banner << std::endl
+		<< "RESOURCEAVAILABILITIES:" << std::endl;
+	for ( int k = 0; k < m; ++k )
+		os << "  R " << k+1;
+	os << std::endl;
+	for ( int k = 0; k < m; ++k )
+		os << ' ' << std::setw( 5 ) << p.getResourceCapacity( k );
+	os << std::endl << banner << std::endl;
+}
@@ -1,4 +1,5 @@
 #include "resource.hpp"
+#include "stats.hpp"
 #include "pstream.h"
 #include <set>
 #include <iomanip>
@@ -16,6 +17,27 @@ Resource::Resource( int tmax, int rmax ) :
 {
 }
 
+void Resource::reset()
+{
+	for ( int t = 0; t < getMaxTime(); ++t )
+	{
+		std::fill( _use[t].begin(), _use[t].end(), 0 );
+	}
+}
+
+void Resource::resize( int tmax, int rmax )
+{
+	STATS_COUNT( Allocations, tmax > getMaxTime() || rmax != getCapacity() );
+
+	// Rows of another capacity cannot be reused
+	if ( rmax != getCapacity() )
+		_use.clear();
+
+	// The new periods are free, the kept ones are cleared
+	_use.resize( tmax, std::vector<int>( rmax ) );
+	reset();
+}
+
 int Resource::getAvailable( int t ) const
 {
 	// Function: int -> bool, return true if the argument equals to 0, false otherwise
@@ -36,8 +58,12 @@ int Resource::findSpace( int t, int req, int duration ) const
 	if ( req == 0 || duration == 0 )
 		return t;
 
+#if STATS
+	const int first( t );
+#endif
 	bool feasible( false );
-	for ( int i = t; i < getMaxTime() && !feasible; ++i )
+	int i;
+	for ( i = t; i < getMaxTime() && !feasible; ++i )
 	{
 		// To find a space, we have to have enough capacity during "len" consecutive iterations
 		if ( req <= getAvailable( i ) )
@@ -51,8 +77,12 @@ int Resource::findSpace( int t, int req, int duration ) const
 			t = i+1;
 		}
 	}
-	// Return -1 if no space has been found
-	return feasible ? t : -1;
+	STATS_COUNT( FindSpace, 1 );
+	STATS_COUNT( PeriodsScanned, i - first );
+
+	// The periods after the horizon are free: if no space has been found
+	// before, it starts at t (the horizon must be extended to use it)
+	return t;
 }
 
 void Resource::assign( int t, int req, int duration, int j )
@@ -61,16 +91,37 @@ void Resource::assign( int t, int req, int duration, int j )
 	{
 		// Fill units until charge reaches req.
 		int charge( 0 );
-		for( int r = 0; r < getCapacity(); ++r )
+		for( int r = 0; r < getCapacity() && charge < req; ++r )
 		{
 			if ( getUsage( i, r ) == 0 )
 			{
 				setUsage( i, r, j );
 				++charge;
 			}
+		}
+	}
+}
 
-			if ( charge >= req )
-				break;
+void Resource::resizeTime( int tmax )
+{
+	STATS_COUNT( Allocations, tmax > getMaxTime() );
+	_use.resize( tmax, std::vector<int>( getCapacity() ) );
+}
+
+void Resource::unassign( int t, int req, int duration, int j )
+{
+	// Nothing is assigned after the maximal time
+	for ( int i = t; i < t+duration && i < getMaxTime(); ++i )
+	{
+		// Free units until the req squares of the job are found
+		int charge( 0 );
+		for ( int r = 0; r < getCapacity() && charge < req; ++r )
+		{
+			if ( getUsage( i, r ) == j )
+			{
+				setUsage( i, r, 0 );
+				++charge;
+			}
 		}
 	}
 }
@@ -0,0 +1,25 @@
+#include "scanner.hpp"
+#include <cstring>
+
+bool Scanner::find( const char * label )
+{
+	std::size_t n( std::strlen( label ) );
+
+	// Candidates are the occurrences of the first character
+	while ( _end - _position >= (long)n )
+	{
+		const char * c = static_cast<const char *>( std::memchr( _position, label[0], _end - _position - n + 1 ) );
+		if ( c == 0 )
+			break;
+
+		if ( std::memcmp( c, label, n ) == 0 )
+		{
+			_position = c + n;
+			return true;
+		}
+		_position = c + 1;
+	}
+
+	_position = _end;
+	return false;
+}
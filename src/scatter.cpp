@@ -0,0 +1,323 @@
+#include "scatter.hpp"
+#include "elite.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <stdlib.h>
+
+/*
+	Combination of a pair of reference lists, run by a worker thread.
+	Each task owns its child solution, so no state is shared while running.
+*/
+class CombinationTask : public Task
+{
+public:
+	CombinationTask( const Problem & p, int strategy, int moves, Archive * archive, const Budget * budget );
+
+	/*
+		Set the parents of the next combination and its random seed
+	*/
+	void setParents( const std::vector<int> * a, const std::vector<int> * b, unsigned int seed );
+
+	/*
+		Two-point crossover, decoding and improvement of the child
+	*/
+	virtual void run();
+
+	Solution child;
+	int numEvaluations;
+
+private:
+	const std::vector<int> * _a,
+	                       * _b;
+	unsigned int _seed;
+	int _strategy,
+	    _moves;
+	Archive * _archive;
+	const Budget * _budget;
+	std::vector<bool> _taken;
+};
+
+CombinationTask::CombinationTask( const Problem & p, int strategy, int moves, Archive * archive, const Budget * budget ) :
+	child( p ),
+	numEvaluations( 0 ),
+	_a( 0 ),
+	_b( 0 ),
+	_seed( 0 ),
+	_strategy( strategy ),
+	_moves( moves ),
+	_archive( archive ),
+	_budget( budget ),
+	_taken( p.getNumJobs() )
+{
+}
+
+void CombinationTask::setParents( const std::vector<int> * a, const std::vector<int> * b, unsigned int seed )
+{
+	_a = a;
+	_b = b;
+	_seed = seed;
+}
+
+void CombinationTask::run()
+{
+	// The pairs still queued when the search stops are skipped
+	if ( _budget && _budget->isExhausted() )
+	{
+		numEvaluations = 0;
+		return;
+	}
+
+	const std::vector<int> & a( *_a ), & b( *_b );
+	int n( child.size() ), q1( rand_r( &_seed ) % ( n+1 ) ), q2( rand_r( &_seed ) % ( n+1 ) );
+
+	if ( q1 > q2 )
+		std::swap( q1, q2 );
+
+	// [0,q1) from a, [q1,q2) in the order of b, [q2,n) in the order of a:
+	// every job comes after its predecessors in both parents, so in the child
+	std::fill( _taken.begin(), _taken.end(), false );
+	int i( 0 ), ia( 0 ), ib( 0 );
+	for ( ; i < q1; ++i )
+	{
+		child[i] = a[i];
+		_taken[a[i]] = true;
+	}
+	for ( ; i < q2; ++i )
+	{
+		while ( _taken[b[ib]] ) ++ib;
+		child[i] = b[ib];
+		_taken[b[ib]] = true;
+	}
+	for ( ; i < n; ++i )
+	{
+		while ( _taken[a[ia]] ) ++ia;
+		child[i] = a[ia];
+		_taken[a[ia]] = true;
+	}
+
+	child.update();
+	numEvaluations = 1;
+
+	numEvaluations += child.localSearch( _strategy, _moves );
+
+	if ( _archive )
+		_archive->publish( child );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+ScatterSearch::ScatterSearch( const Problem & p ) :
+	_problem( p ),
+	_quality( 5 ),
+	_diversity( 5 ),
+	_populationSize( 100 ),
+	_strategy( Solution::FirstImprovement ),
+	_moves( 1000 ),
+	_maxIterations( 100 ),
+	_numThreads( 0 ),
+	_numEvaluations( 0 ),
+	_alpha( 0.75 ),
+	_archive( 0 ),
+	_budget( 0 ),
+	_seed( 1 )
+{
+}
+
+ScatterSearch::~ScatterSearch()
+{
+	for ( int t = 0; t < (int)_tasks.size(); ++t )
+	{
+		delete _tasks[t];
+	}
+}
+
+void ScatterSearch::solve( Solution & s )
+{
+	ThreadPool pool( _numThreads );
+
+	_numEvaluations = 0;
+	_refSet.clear();
+	_refCmax.clear();
+	_refNew.clear();
+
+	diversify( 0 );
+	insert( s.getSequence(), s.getCmax() );
+
+	for ( int iteration = 0; iteration < _maxIterations && !( _budget && _budget->isExhausted() ); ++iteration )
+	{
+		int numTasks( 0 );
+		bool improved( false );
+
+		// Subsets: the pairs with at least one list which has not been combined yet
+		for ( int i = 0; i < (int)_refSet.size(); ++i )
+		{
+			for ( int j = i+1; j < (int)_refSet.size(); ++j )
+			{
+				if ( !_refNew[i] && !_refNew[j] )
+					continue;
+
+				if ( numTasks == (int)_tasks.size() )
+					_tasks.push_back( new CombinationTask( _problem, _strategy, _moves, _archive, _budget ) );
+
+				// Seeds are drawn here so that the result does not depend on the threads
+				_tasks[numTasks]->setParents( &_refSet[i], &_refSet[j], rand_r( &_seed ) );
+				pool.push( _tasks[numTasks] );
+				++numTasks;
+			}
+		}
+		pool.wait();
+
+		std::fill( _refNew.begin(), _refNew.end(), false );
+
+		// Reference set update, in the order of the pairs
+		for ( int t = 0; t < numTasks; ++t )
+		{
+			// Skipped because the budget is exhausted
+			if ( _tasks[t]->numEvaluations == 0 )
+				continue;
+
+			_numEvaluations += _tasks[t]->numEvaluations;
+			if ( _budget )
+				_budget->count( _tasks[t]->numEvaluations );
+
+			if ( insert( _tasks[t]->child.getSequence(), _tasks[t]->child.getCmax() ) )
+				improved = true;
+		}
+
+		// No new list: rebuild the diverse part of the reference set
+		if ( !improved )
+			diversify( _quality );
+	}
+
+	int best( std::min_element( _refCmax.begin(), _refCmax.end() ) - _refCmax.begin() );
+	s.setSequence( _refSet[best] );
+}
+
+void ScatterSearch::diversify( int quality )
+{
+	std::vector< std::vector<int> > sequences;
+	std::vector< std::pair<int,int> > order;
+	std::vector<int> cmax;
+	Solution s( _problem );
+
+	// Keep the best lists of the reference set
+	for ( int i = 0; i < (int)_refSet.size(); ++i )
+	{
+		order.push_back( std::make_pair( _refCmax[i], i ) );
+	}
+	std::sort( order.begin(), order.end() );
+	for ( int i = 0; i < (int)order.size() && i < quality; ++i )
+	{
+		sequences.push_back( _refSet[order[i].second] );
+		cmax.push_back( order[i].first );
+	}
+	_refSet.swap( sequences );
+	_refCmax.swap( cmax );
+	_refNew.assign( _refSet.size(), false );
+
+	// Diversification generator
+	sequences.clear();
+	cmax.clear();
+	for ( int n = 0; n < _populationSize && !( _budget && _budget->isExhausted() ); ++n )
+	{
+		int evaluations( 1 );
+
+		s.grasp( _alpha, _seed );
+
+		evaluations += s.localSearch( _strategy, _moves );
+
+		_numEvaluations += evaluations;
+		if ( _budget )
+			_budget->count( evaluations );
+
+		sequences.push_back( s.getSequence() );
+		cmax.push_back( s.getCmax() );
+	}
+
+	// Elite lists found by the other solvers
+	for ( int i = 0; _archive && i < _archive->size(); ++i )
+	{
+		sequences.push_back( _archive->get( i )->sequence );
+		cmax.push_back( _archive->get( i )->cmax );
+	}
+
+	std::vector<bool> used( sequences.size(), false );
+
+	// The best distinct lists...
+	while ( (int)_refSet.size() < _quality )
+	{
+		int k( -1 );
+		for ( int i = 0; i < (int)sequences.size(); ++i )
+		{
+			if ( !used[i] && ( k < 0 || cmax[i] < cmax[k] ) )
+				k = i;
+		}
+
+		if ( k < 0 )
+			break;
+
+		used[k] = true;
+		if ( getMinDistance( sequences[k] ) > 0 )
+		{
+			_refSet.push_back( sequences[k] );
+			_refCmax.push_back( cmax[k] );
+			_refNew.push_back( true );
+		}
+	}
+
+	// ... then the lists the farthest from the reference set
+	while ( (int)_refSet.size() < _quality + _diversity )
+	{
+		int k( -1 ), dk( 0 );
+		for ( int i = 0; i < (int)sequences.size(); ++i )
+		{
+			int d = used[i] ? 0 : getMinDistance( sequences[i] );
+			if ( d > dk )
+			{
+				k = i;
+				dk = d;
+			}
+		}
+
+		if ( k < 0 )
+			break;
+
+		used[k] = true;
+		_refSet.push_back( sequences[k] );
+		_refCmax.push_back( cmax[k] );
+		_refNew.push_back( true );
+	}
+}
+
+bool ScatterSearch::insert( const std::vector<int> & sequence, int cmax )
+{
+	if ( getMinDistance( sequence ) == 0 )
+		return false;
+
+	if ( (int)_refSet.size() < _quality + _diversity )
+	{
+		_refSet.push_back( sequence );
+		_refCmax.push_back( cmax );
+		_refNew.push_back( true );
+		return true;
+	}
+
+	int worst( std::max_element( _refCmax.begin(), _refCmax.end() ) - _refCmax.begin() );
+	if ( cmax >= _refCmax[worst] )
+		return false;
+
+	_refSet[worst] = sequence;
+	_refCmax[worst] = cmax;
+	_refNew[worst] = true;
+	return true;
+}
+
+int ScatterSearch::getMinDistance( const std::vector<int> & sequence ) const
+{
+	int d( sequence.size() + 1 );
+	for ( int i = 0; i < (int)_refSet.size(); ++i )
+	{
+		d = std::min( d, ElitePool::distance( sequence, _refSet[i] ) );
+	}
+	return d;
+}
@@ -1,18 +1,27 @@
 #include "solution.hpp"
+#include "stats.hpp"
 #include <algorithm>
 #include <stdexcept>
 
-Solution::Solution()
+Solution::Solution() :
+	_problem( 0 ),
+	_decoded( 0 )
 {
 }
 
-Solution::Solution( const Problem & p )
+Solution::Solution( const Problem & p ) :
+	_problem( 0 ),
+	_decoded( 0 )
 {
 	setProblem( p );
 }
 
 Solution::Solution( const Solution & s ) :
+	_problem( s._problem ),
 	_sequence( s._sequence ),
+	_position( s._position ),
+	_saved( s._saved ),
+	_decoded( s._decoded ),
 	_jobs(),
 	_resources( s._resources )
 {
@@ -46,24 +55,43 @@ Solution::~Solution()
 
 void Solution::setProblem( const Problem & p )
 {
-	int jmax( p.getNumJobs() ), tmax( p.getUpperBound() ), rmax( p.getNumResources() );
+	int jmax( p.getNumJobs() ), tmax( p.getHeuristicBound() ), rmax( p.getNumResources() );
 
-	// Clear all existing memory
-	clear();
+	// The resource tables grow on demand: start from a known schedule length
+	if ( tmax <= 0 )
+		tmax = p.getUpperBound();
+
+	// Keep the job objects of a problem of the same size (e.g. the previous
+	// instance of a batch), otherwise clear all existing memory
+	if ( (int)_jobs.size() != jmax || (int)_resources.size() != rmax )
+	{
+		clear();
+		for ( int j = 0; j < jmax; ++j )
+		{
+			_jobs.push_back( new Job( j, rmax ) );
+		}
+		_resources.resize( rmax );
+		STATS_COUNT( Allocations, jmax );
+	}
+	_problem = &p;
 
 	// Allocate a sequence according to the size of the problem
 	_sequence.resize( jmax );
+	_position.resize( jmax );
+	_saved.resize( jmax );
+	_decoded = 0;
 
-	// Allocate job objects
+	// Set the job objects
 	for ( int j = 0; j < jmax; ++j )
 	{
-		Job * job = new Job( j, rmax );
+		Job * job = _jobs[j];
+		job->reset();
+		job->clearPrecedences();
 		job->setDuration( p.getJobDuration( j ) );
 		for ( int k = 0; k < rmax; ++k )
 		{
 			job->setRequest( k, p.getJobRequest( j, k ) );
 		}
-		_jobs.push_back( job );
 	}
 
 	// Make the precedence graph with job pointers
@@ -81,14 +109,14 @@ void Solution::setProblem( const Problem & p )
 		}
 	}
 
-	// Allocate resource objects
+	// Allocate the resource tables
 	for ( int k = 0; k < rmax; ++k )
 	{
-		_resources.push_back( Resource( tmax, p.getResourceCapacity( k ) ) );
+		_resources[k].resize( tmax, p.getResourceCapacity( k ) );
 	}
 }
 
-void Solution::grasp( double alpha )
+void Solution::grasp( double alpha, unsigned int & seed )
 {
 	// Build a valid solution w r t precedence constraints
 	std::vector<int> RCL, u;
@@ -105,23 +133,12 @@ void Solution::grasp( double alpha )
 
 	for ( int pos = 0; pos < (int)_sequence.size(); ++pos )
 	{
-#if VERBOSE
-		for ( int i = 0; i < (int)RCL.size(); ++i )
-		{
-			std::cout << "-- " << i << ' ' << RCL[i] << std::endl;
-		}
-#endif
+		STATS_COUNT( GraspSteps, 1 );
+		STATS_COUNT( GraspCandidates, RCL.size() );
 
 		// Sort utility
 		sortByUtility( RCL, u );
 
-#if VERBOSE
-		for ( int i = 0; i < (int)RCL.size(); ++i )
-		{
-			std::cout << "__ " << i << ' ' << RCL[i] << ' ' << u[i] << std::endl;
-		}
-#endif
-
 		int umin = u.back();
 		int umax = u.front();
 		int ulimit = umin + alpha * ( umax - umin );
@@ -129,15 +146,8 @@ void Solution::grasp( double alpha )
 		int s = 0;
 		while ( s < (int)u.size() && u[s] >= ulimit ) ++s;
 
-#if VERBOSE
-		std::cout << "umin = " << umin << std::endl
-			<< "umax = " << umax << std::endl
-			<< "ulimit = " << ulimit << std::endl
-			<< "s = " << s << std::endl;
-#endif
-
 		// Choose an eligible job (with only selected predecessors or no predecessor)
-		int p = std::rand() % s;
+		int p = rand_r( &seed ) % s;
 		int q = RCL[p];
 
 		// Append the job to the list
@@ -194,34 +204,283 @@ void Solution::reset()
 	}
 }
 
+unsigned long Solution::getScheduleHash() const
+{
+	// FNV-1a over the start times, in the order of the job ids
+	unsigned long h( 14695981039346656037UL );
+	for ( int j = 0; j < (int)_jobs.size(); ++j )
+	{
+		h ^= (unsigned long)_jobs[j]->getStartTime();
+		h *= 1099511628211UL;
+	}
+	return h;
+}
+
 int Solution::getMinStartTimeOfJob( int j ) const
 {
-	int t = _jobs[j]->getPredMaxFinishTime();
+	int t = _jobs[j]->getPredMaxFinishTime(), k( 0 ), last( 0 );
 
-	for ( int k = 0; k < (int)_resources.size(); ++k )
+	if ( _resources.empty() )
+		return t;
+
+	// Find the leftmost available space in all resources: when a resource
+	// delays the job, the other ones are checked again from the new time
+	do
 	{
-		// Find the leftmost available space in all resources
-		t = std::max( t, _resources[k].findSpace( t, _jobs[j]->getRequest( k ), _jobs[j]->getDuration() ) );
+		int s = _resources[k].findSpace( t, _jobs[j]->getRequest( k ), _jobs[j]->getDuration() );
+		if ( s > t )
+		{
+			t = s;
+			last = k;
+		}
+		k = ( k + 1 ) % (int)_resources.size();
 	}
+	while ( k != last );
 
 	return t;
 }
 
+void Solution::setSequence( const std::vector<int> & sequence )
+{
+	_sequence = sequence;
+	update();
+}
+
 void Solution::update()
 {
-	for ( int j = 0; j < size(); ++j )
+	reset();
+	decode( 0 );
+}
+
+void Solution::update( int i )
+{
+	update( i, std::numeric_limits<int>::max() );
+}
+
+bool Solution::update( int i, int cutoff )
+{
+	// Take the jobs of the tail out of the scheduling, the head stays in place
+	for ( int j = i; j < size(); ++j )
+	{
+		Job * job = _jobs[_sequence[j]];
+		_saved[job->getId()] = job->getStartTime();
+
+		for ( int k = 0; k < (int)_resources.size(); ++k )
+		{
+			_resources[k].unassign( job->getStartTime(), job->getRequest( k ), job->getDuration(), job->getId()+1 );
+		}
+	}
+
+	return decode( i, cutoff );
+}
+
+bool Solution::decode( int i, int cutoff )
+{
+	STATS_COUNT( Decodes, 1 );
+
+	for ( int j = i; j < size(); ++j )
 	{
-		int t( 0 ), i( _sequence[j] );
+		int t( 0 ), q( _sequence[j] );
+
+		_position[q] = j;
+
+		t = getMinStartTimeOfJob( q );
+		_jobs[q]->setStartTime( t );
+
+		// The sink cannot finish before this job and its tail (latest start
+		// time tightened by the constraint propagation of the problem)
+		if ( cutoff < std::numeric_limits<int>::max() && t > _problem->getJobLatestStart( q, cutoff ) )
+		{
+			_decoded = j;
+			return false;
+		}
 
-		t = getMinStartTimeOfJob( i );
-		_jobs[i]->setStartTime( t );
+		if ( _jobs[q]->getFinishTime() > getMaxTime() )
+			setMaxTime( std::max( _jobs[q]->getFinishTime(), 2 * getMaxTime() ) );
 
 		for ( int k = 0; k < (int)_resources.size(); ++k )
 		{
 			// Add the current job to the scheduling
-			_resources[k].assign( t, _jobs[i]->getRequest( k ), _jobs[i]->getDuration(), i+1 );
+			_resources[k].assign( t, _jobs[q]->getRequest( k ), _jobs[q]->getDuration(), q+1 );
 		}
+		STATS_COUNT( Assignments, 1 );
 	}
+
+	_decoded = size();
+	return true;
+}
+
+void Solution::undo( int i, int k )
+{
+	int from( std::min( i, k ) );
+
+	// Free the squares of the jobs rescheduled since the move
+	for ( int j = from; j < _decoded; ++j )
+	{
+		Job * job = _jobs[_sequence[j]];
+
+		for ( int r = 0; r < (int)_resources.size(); ++r )
+		{
+			_resources[r].unassign( job->getStartTime(), job->getRequest( r ), job->getDuration(), job->getId()+1 );
+		}
+	}
+
+	// The tail holds the same jobs in the former order, which was feasible
+	// at the saved start times: no space has to be searched
+	move( k, i );
+	for ( int j = from; j < size(); ++j )
+	{
+		Job * job = _jobs[_sequence[j]];
+
+		job->setStartTime( _saved[job->getId()] );
+		for ( int r = 0; r < (int)_resources.size(); ++r )
+		{
+			_resources[r].assign( job->getStartTime(), job->getRequest( r ), job->getDuration(), job->getId()+1 );
+		}
+	}
+	_decoded = size();
+}
+
+int Solution::relink( const std::vector<int> & guide )
+{
+	std::vector<int> best( _sequence );
+	int bestCmax( getCmax() ), evaluated( 0 );
+
+	for ( int i = 0; i < size(); ++i )
+	{
+		if ( _sequence[i] == guide[i] )
+			continue;
+
+		// The positions before i already match the guide, which holds all the
+		// predecessors of guide[i], so the job can be moved forward to i
+		move( _position[guide[i]], i );
+		update( i );
+		++evaluated;
+
+		if ( getCmax() < bestCmax )
+		{
+			bestCmax = getCmax();
+			best = _sequence;
+		}
+	}
+
+	_sequence = best;
+	update();
+
+	return evaluated;
+}
+
+void Solution::getMoveWindow( int i, int & lo, int & hi ) const
+{
+	Job * job = getJobAt( i );
+
+	// The job must stay after all its predecessors...
+	lo = 0;
+	for ( int k = 0; k < (int)job->getPredecessors().size(); ++k )
+	{
+		lo = std::max( lo, _position[job->getPredecessors()[k]->getId()] + 1 );
+	}
+
+	// ... and before all its successors
+	hi = size() - 1;
+	for ( int k = 0; k < (int)job->getSuccessors().size(); ++k )
+	{
+		hi = std::min( hi, _position[job->getSuccessors()[k]->getId()] - 1 );
+	}
+}
+
+void Solution::move( int i, int k )
+{
+	if ( i < k )
+	{
+		std::rotate( _sequence.begin() + i, _sequence.begin() + i + 1, _sequence.begin() + k + 1 );
+	}
+	else
+	{
+		std::rotate( _sequence.begin() + k, _sequence.begin() + i, _sequence.begin() + i + 1 );
+	}
+
+	for ( int j = std::min( i, k ); j <= std::max( i, k ); ++j )
+	{
+		_position[_sequence[j]] = j;
+	}
+}
+
+int Solution::localSearch( int strategy, int budget )
+{
+	int evaluated( 0 );
+	bool improved( true );
+
+	while ( improved && evaluated < budget )
+	{
+		int cmax( getCmax() ), bestI( 0 ), bestK( 0 );
+		improved = false;
+
+		// The source and the sink never move
+		for ( int i = 1; i < size()-1 && evaluated < budget; ++i )
+		{
+			int lo, hi;
+			getMoveWindow( i, lo, hi );
+
+			for ( int k = lo; k <= hi && evaluated < budget; ++k )
+			{
+				if ( k == i )
+					continue;
+
+				// Only the jobs from the first changed position are rescheduled,
+				// and the decoding stops as soon as the move cannot improve
+				move( i, k );
+				++evaluated;
+
+				if ( update( std::min( i, k ), cmax-1 ) )
+				{
+					cmax = getCmax();
+					bestI = i;
+					bestK = k;
+					improved = true;
+
+					// Keep the move and restart from the new list
+					if ( strategy == FirstImprovement )
+						break;
+				}
+
+				undo( i, k );
+			}
+
+			if ( improved && strategy == FirstImprovement )
+				break;
+		}
+
+		if ( improved && strategy == BestImprovement )
+		{
+			move( bestI, bestK );
+			update( std::min( bestI, bestK ) );
+		}
+	}
+
+	return evaluated;
+}
+
+int Solution::getMaxTime() const
+{
+	return _resources.empty() ? std::numeric_limits<int>::max() : _resources[0].getMaxTime();
+}
+
+void Solution::setMaxTime( int tmax )
+{
+	for ( int k = 0; k < (int)_resources.size(); ++k )
+	{
+		_resources[k].resizeTime( tmax );
+	}
+}
+
+void Solution::shrink( int tmax )
+{
+	// The periods after Cmax are empty, the schedule is kept
+	tmax = std::max( tmax, getCmax() );
+
+	if ( tmax < getMaxTime() )
+		setMaxTime( tmax );
 }
 
 void Solution::exportGnuplot() const
@@ -260,6 +519,13 @@ void Solution::clear()
 	{
 		delete _jobs[j];
 	}
+	_jobs.clear();
+	_resources.clear();
+	_sequence.clear();
+	_position.clear();
+	_saved.clear();
+	_decoded = 0;
+	_problem = 0;
 }
 
 void Solution::sortByUtility( std::vector<int> & RCL, std::vector<int> & u ) const
@@ -271,9 +537,9 @@ void Solution::sortByUtility( std::vector<int> & RCL, std::vector<int> & u ) con
 		int r = 0;
 		for ( int k = 0; k < (int)_resources.size(); ++k )
 		{
-			r += _jobs[k]->getRequest( k );
+			r += _jobs[j]->getRequest( k );
 		}
-		int v = _jobs[j]->getDuration() / r;
+		int v = _jobs[j]->getDuration() / std::max( 1, r );
 
 		bool placed = false;
 		for ( int k = 0; k < i && !placed; ++k )
@@ -0,0 +1,156 @@
+#include "solver.hpp"
+#include "tabu.hpp"
+#include "annealing.hpp"
+#include "elite.hpp"
+#include "scatter.hpp"
+#include "branchbound.hpp"
+#include "hashset.hpp"
+#include "archive.hpp"
+#include "arguments.hpp"
+#include "stats.hpp"
+#include <cstdlib>
+#include <limits>
+
+Solver::Solver() :
+	_numThreads( 0 ),
+	_bestCmax( 0 ),
+	_lowerBound( 0 ),
+	_numDuplicates( 0 ),
+	_summary( 0 ),
+	_seed( 1 )
+{
+}
+
+void Solver::solve( const Problem & p, Budget & budget )
+{
+	STATS_PHASE( Search );
+
+	// Random state of this solve, the engines are seeded from it
+	unsigned int seed( _seed );
+
+	// Elite solutions for path relinking
+	ElitePool elite( arguments::elite_size, arguments::elite_distance );
+
+	// Schedules already in the population
+	HashSet schedules( arguments::diversity_window, arguments::diversity_threshold );
+
+	// Stopping criteria shared by all the engines and threads
+	budget.setTimeLimit( arguments::time_limit );
+	budget.setMaxSchedules( arguments::max_schedules );
+	budget.setTarget( std::max( arguments::target_makespan, p.getLowerBound() ) ); // Optimality is proven at the lower bound
+	budget.setStagnation( arguments::stagnation );
+
+	// Best solutions shared by all the engines and threads
+	Archive archive( arguments::elite_size );
+	archive.setBudget( &budget );
+
+	// A time or schedule limit replaces the number of iterations
+	int iterations = budget.isLimited() ? std::numeric_limits<int>::max() : arguments::iterations;
+
+	// Lower bound of the best makespan (raised by a proof of the exact engine)
+	_lowerBound = p.getLowerBound();
+
+	// The working solution is rebuilt by GRASP at each iteration
+	_solution.setProblem( p );
+
+	// Generate an initial population (GRASP alone runs until the budget is exhausted).
+	// Only the accepted solutions count, the attempts are limited for the
+	// instances with fewer distinct schedules than the population size
+	const int maxAttempts( 10 * arguments::population_size );
+	for ( int i = 0, attempts = 0;
+	      archive.getBest() == 0 || ( ( ( i < arguments::population_size && attempts < maxAttempts )
+	        || ( arguments::engine == arguments::engine_grasp && budget.isLimited() ) ) && !budget.isExhausted() );
+	      ++attempts )
+	{
+		Solution & s( _solution );
+		int evaluations( 1 );
+
+		// Build a solution using GRASP, or a random immigrant (alpha = 0)
+		// when the last solutions were mostly duplicates
+		s.grasp( arguments::dedup && schedules.isStagnating() ? 0.0 : arguments::alpha, seed );
+
+		// Improve it with a local search step
+		if ( arguments::local_search )
+			evaluations += s.localSearch( arguments::local_search, arguments::local_search_moves );
+
+		// Intensify toward a random elite solution (GRASP with path relinking)
+		if ( arguments::path_relinking && elite.size() > 0 )
+			evaluations += s.relink( elite.getSequence( rand_r( &seed ) % elite.size() ) );
+
+		// Update changes
+		s.update();
+		budget.count( evaluations );
+
+		// Reject the schedules already in the population
+		if ( arguments::dedup && !schedules.insert( s ) )
+			continue;
+
+		++i;
+		archive.publish( s );
+
+		if ( arguments::path_relinking )
+			elite.insert( s );
+	}
+
+
+	// Improve the best solution with another engine
+	_best.setProblem( p );
+	_best.setSequence( archive.getBest()->sequence );
+
+	if ( arguments::engine == arguments::engine_tabu )
+	{
+		TabuSearch ts( p );
+		ts.setTenure( arguments::tabu_tenure );
+		ts.setSampleSize( arguments::tabu_sample );
+		ts.setMaxIterations( iterations );
+		ts.setArchive( &archive );
+		ts.setBudget( &budget );
+		ts.setSeed( rand_r( &seed ) );
+		ts.solve( _best );
+	}
+	else if ( arguments::engine == arguments::engine_annealing )
+	{
+		SimulatedAnnealing sa( p );
+		sa.setTemperature( arguments::sa_temperature );
+		sa.setCooling( arguments::sa_cooling, arguments::sa_rate );
+		sa.setReheat( arguments::sa_reheat );
+		// Moves are single decodes: the budget is counted in evaluations, not iterations
+		sa.setMaxEvaluations( budget.isLimited() ? std::numeric_limits<int>::max() : arguments::sa_evaluations );
+		sa.setArchive( &archive );
+		sa.setBudget( &budget );
+		sa.setSeed( rand_r( &seed ) );
+		sa.solve( _best );
+		if ( _summary )
+			sa.exportSummary( *_summary );
+	}
+	else if ( arguments::engine == arguments::engine_scatter )
+	{
+		ScatterSearch ss( p );
+		ss.setRefSetSize( arguments::refset_quality, arguments::refset_diversity );
+		ss.setPopulationSize( arguments::population_size );
+		ss.setAlpha( arguments::alpha );
+		// The improvement method is part of scatter search, the option only chooses it
+		ss.setLocalSearch( arguments::local_search ? arguments::local_search : (int)Solution::FirstImprovement, arguments::local_search_moves );
+		ss.setMaxIterations( iterations );
+		ss.setNumThreads( _numThreads );
+		ss.setArchive( &archive );
+		ss.setBudget( &budget );
+		ss.setSeed( rand_r( &seed ) );
+		ss.solve( _best );
+	}
+	else if ( arguments::engine == arguments::engine_exact )
+	{
+		BranchAndBound bb( p );
+		bb.setArchive( &archive );
+		bb.setBudget( &budget );
+		bb.solve( _best );
+		if ( _summary )
+			bb.exportSummary( *_summary );
+		_lowerBound = std::max( _lowerBound, bb.getLowerBound() );
+	}
+
+	// Result
+	_best.setSequence( archive.getBest()->sequence );
+	_bestCmax = archive.getBestCmax();
+	_numDuplicates = schedules.getNumDuplicates();
+}
@@ -0,0 +1,134 @@
+#include "stats.hpp"
+#include "timer.hpp"
+#include <pthread.h>
+
+/*
+	Counters and phase times of a thread
+*/
+struct StatsLocal
+{
+	StatsLocal() :
+		phase( stats::None ),
+		switched( 0.0 )
+	{
+		clear();
+	}
+
+	void clear()
+	{
+		for ( int c = 0; c < stats::NumCounters; ++c )
+			counters[c] = 0;
+		for ( int p = 0; p < stats::NumPhases; ++p )
+			seconds[p] = 0.0;
+	}
+
+	long counters[stats::NumCounters];
+	double seconds[stats::NumPhases];
+	int phase;         // Current phase
+	double switched;   // Time of the last change of phase
+	Timer clock;
+};
+
+static long statsCounters[stats::NumCounters];
+static double statsSeconds[stats::NumPhases];
+static pthread_mutex_t statsMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_key_t statsKey;
+static pthread_once_t statsOnce = PTHREAD_ONCE_INIT;
+static __thread StatsLocal * statsLocal = 0;
+
+// Move the counters of a thread to the totals (the caller holds the mutex)
+static void statsAdd( StatsLocal & local )
+{
+	for ( int c = 0; c < stats::NumCounters; ++c )
+		statsCounters[c] += local.counters[c];
+	for ( int p = 0; p < stats::NumPhases; ++p )
+		statsSeconds[p] += local.seconds[p];
+	local.clear();
+}
+
+// Merge the counters of an ending thread
+static void statsMerge( void * data )
+{
+	StatsLocal * local = static_cast<StatsLocal *>( data );
+
+	pthread_mutex_lock( &statsMutex );
+	statsAdd( *local );
+	pthread_mutex_unlock( &statsMutex );
+
+	delete local;
+}
+
+static void statsCreateKey()
+{
+	pthread_key_create( &statsKey, &statsMerge );
+}
+
+// The counters of the calling thread, merged when it ends
+static StatsLocal & statsGetLocal()
+{
+	if ( statsLocal == 0 )
+	{
+		pthread_once( &statsOnce, &statsCreateKey );
+		statsLocal = new StatsLocal();
+		pthread_setspecific( statsKey, statsLocal );
+	}
+	return *statsLocal;
+}
+
+// Charge the time since the last change to the current phase, and change it
+static int statsSwitch( int phase )
+{
+	StatsLocal & local( statsGetLocal() );
+	double now( local.clock.getElapsed() );
+	int previous( local.phase );
+
+	local.seconds[previous] += now - local.switched;
+	local.switched = now;
+	local.phase = phase;
+	return previous;
+}
+
+void stats::count( int counter, long n )
+{
+	statsGetLocal().counters[counter] += n;
+}
+
+stats::PhaseTimer::PhaseTimer( int phase ) :
+	_previous( statsSwitch( phase ) )
+{
+}
+
+stats::PhaseTimer::~PhaseTimer()
+{
+	statsSwitch( _previous );
+}
+
+void stats::report( std::ostream & os )
+{
+	static const char * const counters[] = {
+		"Decodes", "findSpace calls", "Periods scanned", "Assignments",
+		"GRASP steps", "GRASP candidates", "Cache hits", "Allocations" };
+	static const char * const phases[] = { "Other", "Parse", "Init", "Search", "Export" };
+
+	if ( !STATS )
+	{
+		os << "Statistics: not compiled in (make STATS=1)" << std::endl;
+		return;
+	}
+
+	pthread_mutex_lock( &statsMutex );
+
+	// The calling thread is still running: charge its current phase until now
+	if ( statsLocal != 0 )
+	{
+		statsSwitch( statsLocal->phase );
+		statsAdd( *statsLocal );
+	}
+
+	os << "Statistics:" << std::endl;
+	for ( int c = 0; c < NumCounters; ++c )
+		os << '\t' << counters[c] << ": " << statsCounters[c] << std::endl;
+	for ( int p = Parse; p < NumPhases; ++p )
+		os << '\t' << phases[p] << " time: " << statsSeconds[p] << " s" << std::endl;
+	pthread_mutex_unlock( &statsMutex );
+}
@@ -0,0 +1,98 @@
+#include "tabu.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+TabuSearch::TabuSearch( const Problem & ) :
+	_tenure( 7 ),
+	_sampleSize( 50 ),
+	_maxIterations( 1000 ),
+	_numEvaluations( 0 ),
+	_archive( 0 ),
+	_budget( 0 ),
+	_seed( 1 ),
+	_last( 0 )
+{
+}
+
+void TabuSearch::solve( Solution & s )
+{
+	std::vector<int> best( s.getSequence() );
+	int bestCmax( s.getCmax() );
+
+	_tabu.assign( std::max( 0, _tenure ), Attribute() );
+	_last = 0;
+	_numEvaluations = 0;
+
+	// Nothing can move with less than one job between the source and the sink
+	if ( s.size() < 3 )
+		return;
+
+	for ( int iteration = 1; iteration <= _maxIterations && !( _budget && _budget->isExhausted() ); ++iteration )
+	{
+		int moveI( -1 ), moveK( -1 ), moveCmax( 0 ), evaluations( _numEvaluations );
+
+		// Evaluate a sample of the neighbourhood, so that an iteration stays bounded
+		for ( int n = 0; n < _sampleSize; ++n )
+		{
+			int lo, hi, i, k;
+
+			// The source and the sink never move
+			i = 1 + rand_r( &_seed ) % ( s.size() - 2 );
+			s.getMoveWindow( i, lo, hi );
+			if ( lo == hi )
+				continue;
+
+			k = lo + rand_r( &_seed ) % ( hi - lo );
+			if ( k >= i )
+				++k;
+
+			s.move( i, k );
+			s.update( std::min( i, k ) );
+			++_numEvaluations;
+
+			int cmax( s.getCmax() );
+
+			// Aspiration: a tabu move is allowed if it improves the best solution
+			if ( ( !isTabu( s[k], k, iteration ) || cmax < bestCmax )
+			  && ( moveI < 0 || cmax < moveCmax ) )
+			{
+				moveI = i;
+				moveK = k;
+				moveCmax = cmax;
+			}
+
+			s.undo( i, k );
+		}
+
+		if ( _budget )
+			_budget->count( _numEvaluations - evaluations );
+
+		if ( moveI < 0 )
+			continue;
+
+		// The job cannot go back to its former position for a while: only
+		// the attributes of the last tenure moves can still be tabu
+		if ( !_tabu.empty() )
+		{
+			_last = ( _last + 1 ) % _tabu.size();
+			_tabu[_last].job = s[moveI];
+			_tabu[_last].position = moveI;
+			_tabu[_last].expiry = iteration + _tenure;
+		}
+
+		s.move( moveI, moveK );
+		s.update( std::min( moveI, moveK ) );
+
+		if ( s.getCmax() < bestCmax )
+		{
+			bestCmax = s.getCmax();
+			best = s.getSequence();
+			s.shrink( bestCmax );
+
+			if ( _archive )
+				_archive->publish( s );
+		}
+	}
+
+	s.setSequence( best );
+}
@@ -0,0 +1,97 @@
+#include "threadpool.hpp"
+#include <unistd.h>
+
+Task::~Task()
+{
+}
+
+ThreadPool::ThreadPool( int n ) :
+	_pending( 0 ),
+	_stop( false )
+{
+	pthread_mutex_init( &_mutex, 0 );
+	pthread_cond_init( &_ready, 0 );
+	pthread_cond_init( &_done, 0 );
+
+	if ( n <= 0 )
+		n = getNumProcessors();
+
+	_threads.resize( n );
+	for ( int i = 0; i < n; ++i )
+	{
+		pthread_create( &_threads[i], 0, &ThreadPool::work, this );
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	pthread_mutex_lock( &_mutex );
+	_stop = true;
+	pthread_cond_broadcast( &_ready );
+	pthread_mutex_unlock( &_mutex );
+
+	for ( int i = 0; i < (int)_threads.size(); ++i )
+	{
+		pthread_join( _threads[i], 0 );
+	}
+
+	pthread_cond_destroy( &_done );
+	pthread_cond_destroy( &_ready );
+	pthread_mutex_destroy( &_mutex );
+}
+
+void ThreadPool::push( Task * task )
+{
+	pthread_mutex_lock( &_mutex );
+	_queue.push_back( task );
+	++_pending;
+	pthread_cond_signal( &_ready );
+	pthread_mutex_unlock( &_mutex );
+}
+
+void ThreadPool::wait()
+{
+	pthread_mutex_lock( &_mutex );
+	while ( _pending > 0 )
+	{
+		pthread_cond_wait( &_done, &_mutex );
+	}
+	pthread_mutex_unlock( &_mutex );
+}
+
+int ThreadPool::getNumProcessors()
+{
+	long n = sysconf( _SC_NPROCESSORS_ONLN );
+	return n > 0 ? n : 1;
+}
+
+void * ThreadPool::work( void * pool )
+{
+	ThreadPool * self = static_cast<ThreadPool *>( pool );
+
+	pthread_mutex_lock( &self->_mutex );
+	for ( ;; )
+	{
+		while ( self->_queue.empty() && !self->_stop )
+		{
+			pthread_cond_wait( &self->_ready, &self->_mutex );
+		}
+
+		if ( self->_queue.empty() )
+			break;
+
+		Task * task = self->_queue.front();
+		self->_queue.pop_front();
+
+		// Run the task outside the lock
+		pthread_mutex_unlock( &self->_mutex );
+		task->run();
+		pthread_mutex_lock( &self->_mutex );
+
+		if ( --self->_pending == 0 )
+			pthread_cond_broadcast( &self->_done );
+	}
+	pthread_mutex_unlock( &self->_mutex );
+
+	return 0;
+}
@@ -0,0 +1,24 @@
+#include "timer.hpp"
+#include <time.h>
+
+Timer::Timer() :
+	_start( now() )
+{
+}
+
+void Timer::start()
+{
+	_start = now();
+}
+
+double Timer::getElapsed() const
+{
+	return now() - _start;
+}
+
+double Timer::now()
+{
+	struct timespec ts;
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}